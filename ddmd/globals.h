@@ -217,6 +217,7 @@ struct Param
     bool disableRedZone;
 
     uint32_t hashThreshold; // MD5 hash symbols larger than this threshold (0 = no hashing)
+    bool mangleBackrefs; // use identifier and type back-references in mangled names
 #endif
 };
 
@@ -225,6 +226,24 @@ struct Compiler
     const char *vendor;     // Compiler backend name
 };
 
+#if IN_LLVM
+// Counters reported by -stats
+struct Statistics
+{
+    uint64_t modulesLoaded;
+    uint64_t tokensLexed;
+    uint64_t templateInstancesCreated;
+    uint64_t templateInstancesReused;
+    uint64_t ctfeCalls;
+    uint64_t functionsCodegenned;       // updated by the glue layer
+    uint64_t typeInfosEmitted;          // updated by the glue layer
+    uint64_t inliningCandidates;        // updated by the glue layer
+    uint64_t gaggedErrors;              // errors discarded without being formatted
+    uint64_t spellerSearchesSkipped;    // spelling suggestions not searched for gagged errors
+    uint64_t templateFunctionsPruned;   // updated by the glue layer
+};
+#endif
+
 typedef unsigned structalign_t;
 // magic value means "match whatever the underlying C compiler does"
 // other values are all powers of 2
@@ -244,6 +263,8 @@ struct Global
     const char *llvm_version;
 
     bool gaggedForInlining; // Set for functionSemantic3 for external inlining candidates
+
+    Statistics stats;
 #endif
     const char *lib_ext;
     const char *dll_ext;
@@ -12,6 +12,9 @@
 #include <string.h>                     // memset()
 
 void genhdrfile(Module *m);
+#if IN_LLVM
+void genInterfaceText(Module *m, OutBuffer *buf, bool keepAllBodies);
+#endif
 
 struct HdrGenState
 {
@@ -21,6 +24,10 @@ struct HdrGenState
     int tpltMember;
     int autoMember;
     int forStmtInit;
+#if IN_LLVM
+    bool interfaceHash; // true if generating the text for -interface-hash
+    int inlineMember;   // > 0 inside pragma(inline) declarations
+#endif
 
     HdrGenState() { memset(this, 0, sizeof(HdrGenState)); }
 };
@@ -21,6 +21,10 @@
 struct OutBuffer;
 
 void json_generate(OutBuffer *, Modules *);
+#if IN_LLVM
+class Module;
+void json_generate_module(OutBuffer *, Module *, Strings *);
+#endif
 
 #endif /* DMD_JSON_H */
 
@@ -166,6 +166,17 @@ static cl::opt<bool, true> doJson("X", cl::desc("Generate JSON file"),
 cl::opt<std::string> jsonFile("Xf", cl::desc("Write JSON file to <filename>"),
                               cl::value_desc("filename"), cl::Prefix);
 
+cl::opt<std::string>
+    jsonDir("Xd", cl::desc("Write one JSON file per module to <directory> (in "
+                           "addition to the combined file with -X or -Xf)"),
+            cl::value_desc("directory"), cl::Prefix);
+
+cl::list<std::string> jsonFields(
+    "Xfields",
+    cl::desc("Only write these properties of the symbols to the JSON file "
+             "(e.g. name,kind,file,line)"),
+    cl::value_desc("names"), cl::CommaSeparated);
+
 // Header generation options
 static cl::opt<bool, true>
     doHdrGen("H", cl::desc("Generate 'header' file"),
@@ -188,9 +199,31 @@ static cl::opt<bool, true> unittest("unittest",
                                     cl::location(global.params.useUnitTests));
 
 cl::opt<std::string>
-    ir2objCacheDir("ir2obj-cache", cl::desc("Use <cache dir> to cache object files for whole IR modules (experimental)"),
+    ir2objCacheDir("ir2obj-cache", cl::desc("Use <cache dir> to cache object files for whole IR modules, and executables for -run (experimental)"),
             cl::value_desc("cache dir"), cl::Prefix);
 
+cl::opt<bool> ir2objCachePrune("ir2obj-cache-prune",
+                               cl::desc("Enable pruning of the ir2obj cache"),
+                               cl::ZeroOrMore);
+
+cl::opt<unsigned> ir2objCachePruneInterval(
+    "ir2obj-cache-prune-interval",
+    cl::desc("Sets the ir2obj cache pruning interval in seconds "
+             "(default: 20 min). Set to 0 to force pruning"),
+    cl::value_desc("seconds"), cl::init(20 * 60));
+
+cl::opt<unsigned> ir2objCachePruneExpiration(
+    "ir2obj-cache-prune-expiration",
+    cl::desc("Sets the expiration time of unused ir2obj cache files in seconds "
+             "(default: 1 week)"),
+    cl::value_desc("seconds"), cl::init(7 * 24 * 3600));
+
+cl::opt<unsigned> ir2objCachePruneMaxPercentage(
+    "ir2obj-cache-prune-maxpercentage",
+    cl::desc("Limits the ir2obj cache size to the given percentage of the free "
+             "disk space (default: 75%)"),
+    cl::value_desc("percentage"), cl::init(75));
+
 static StringsAdapter strImpPathStore("J", global.params.fileImppath);
 static cl::list<std::string, StringsAdapter>
     stringImportPaths("J", cl::desc("Where to look for string imports"),
@@ -384,6 +417,13 @@ cl::opt<uint32_t, true> hashThreshold(
     cl::desc("hash symbol names longer than this threshold (experimental)"),
     cl::location(global.params.hashThreshold), cl::init(0));
 
+static cl::opt<bool, true> mangleBackrefs(
+    "mangle-backrefs",
+    cl::desc("Compress mangled D symbol names using identifier and type "
+             "back-references as introduced by DMD 2.077 (experimental; all "
+             "linked code must use the same setting)"),
+    cl::location(global.params.mangleBackrefs), cl::init(false));
+
 cl::opt<bool> linkonceTemplates(
     "linkonce-templates",
     cl::desc(
@@ -51,12 +51,18 @@ extern cl::opt<bool, true> disableRedZone;
 extern cl::opt<std::string> ddocDir;
 extern cl::opt<std::string> ddocFile;
 extern cl::opt<std::string> jsonFile;
+extern cl::opt<std::string> jsonDir;
+extern cl::list<std::string> jsonFields;
 extern cl::opt<std::string> hdrDir;
 extern cl::opt<std::string> hdrFile;
 extern cl::list<std::string> versions;
 extern cl::list<std::string> transitions;
 extern cl::opt<std::string> moduleDepsFile;
 extern cl::opt<std::string> ir2objCacheDir;
+extern cl::opt<bool> ir2objCachePrune;
+extern cl::opt<unsigned> ir2objCachePruneInterval;
+extern cl::opt<unsigned> ir2objCachePruneExpiration;
+extern cl::opt<unsigned> ir2objCachePruneMaxPercentage;
 
 extern cl::opt<std::string> mArch;
 extern cl::opt<bool> m32bits;
@@ -9,14 +9,19 @@
 
 #include "driver/codegenerator.h"
 
+#include "declaration.h"
 #include "id.h"
 #include "mars.h"
 #include "module.h"
 #include "scope.h"
+#include "driver/cl_options.h"
 #include "driver/linker.h"
 #include "driver/toobj.h"
 #include "gen/logger.h"
 #include "gen/runtime.h"
+#include "ir/irdsymbol.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/CommandLine.h"
 
 void codegenModule(IRState *irs, Module *m, bool emitFullModuleInfo);
 
@@ -26,6 +31,20 @@ extern Module *g_entrypointModule;
 /// The module that contains the actual D main() (_Dmain) definition.
 extern Module *g_dMainModule;
 
+static llvm::cl::opt<bool> pruneUnreferenced(
+    "prune-unreferenced",
+    llvm::cl::desc("Only emit template functions and TypeInfos referenced "
+                   "from the generated code (-singleobj executables only; "
+                   "all D modules of the program must be compiled at once)"),
+    llvm::cl::ZeroOrMore);
+
+static llvm::cl::opt<bool> reduceModuleInfoImports(
+    "reduce-moduleinfo-imports",
+    llvm::cl::desc("Omit imports implied by other imports from the "
+                   "ModuleInfos (-singleobj executables only; changes "
+                   "ModuleInfo.importedModules)"),
+    llvm::cl::ZeroOrMore);
+
 namespace {
 
 /// Add the linker options metadata flag.
@@ -139,6 +158,26 @@ void CodeGenerator::prepareLLModule(Module *m) {
   // singleObj compilations?
   ir_->DBuilder.EmitCompileUnit(m);
 
+  // Other object files or a library's users may rely on the template
+  // instances and TypeInfos emitted here, so only prune when this module is
+  // linked into an executable on its own.
+  ir_->pruneUnreferenced = pruneUnreferenced && singleObj_ &&
+                           global.params.link && !opts::createSharedLib;
+  if (pruneUnreferenced && !ir_->pruneUnreferenced) {
+    static bool warned = false;
+    if (!warned) {
+      warning(Loc(), "-prune-unreferenced is ignored unless linking a "
+                     "-singleobj executable");
+      warned = true;
+    }
+  }
+
+  // The reduced import lists only preserve the module constructor order if
+  // all root modules' ModuleInfos are linked together and never mixed with
+  // ones from other compiler invocations.
+  ir_->reduceModuleInfoImports = reduceModuleInfoImports && singleObj_ &&
+                                 global.params.link && !opts::createSharedLib;
+
   IrDsymbol::resetAll();
 }
 
@@ -159,6 +198,14 @@ void CodeGenerator::finishLLModule(Module *m) {
 }
 
 void CodeGenerator::writeAndFreeLLModule(const char *filename) {
+  llvm::SmallPtrSet<FuncDeclaration *, 64> pruned;
+  for (auto fd : ir_->deferredFunctions) {
+    if (!fd->ir->isDefined()) {
+      pruned.insert(fd);
+    }
+  }
+  global.stats.templateFunctionsPruned += pruned.size();
+
   ir_->DBuilder.Finalize();
 
   emitLinkerOptions(*ir_, ir_->module, ir_->context());
@@ -0,0 +1,139 @@
+//===-- interfacehash.cpp -------------------------------------------------===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// The hash is computed over the import file (.di) representation of a module,
+// generated right after parsing just like the -H output. Comments, formatting
+// and the bodies of regular functions do not affect it; templates, auto
+// functions and pragma(inline) functions are hashed including their bodies.
+// With cross-module inlining enabled, all function bodies are part of the
+// interface.
+//
+// The hash file is named after the module's object file, with the extension
+// replaced by .ihash. If all modules are compiled into a single object file,
+// it is named after the fully qualified module name instead (<module>.ihash,
+// placed in the -od directory). It is only rewritten if the hash changed, so
+// that its timestamp can drive the rebuilds of importers (e.g., via Ninja's
+// restat).
+//
+//===----------------------------------------------------------------------===//
+
+#include "driver/interfacehash.h"
+
+#include "errors.h"
+#include "hdrgen.h"
+#include "mars.h"
+#include "module.h"
+#include "root.h"
+#include "gen/logger.h"
+#include "gen/optimizer.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace cl = llvm::cl;
+
+static cl::opt<bool> interfaceHash(
+    "interface-hash",
+    cl::desc("Write a hash of each module's public interface to a .ihash "
+             "file named after its object file (or after the fully qualified "
+             "module name with -singleobj); the file is only touched if the "
+             "hash changed"),
+    cl::ZeroOrMore);
+
+namespace {
+
+const char *const interfaceHashExt = "ihash";
+
+std::string getInterfaceHashPath(Module *m, bool sharedObj) {
+  if (m->objfile && !sharedObj) {
+    return FileName::forceExt(m->objfile->name->str, interfaceHashExt);
+  }
+  // All modules end up in one object file; name the hash file after the
+  // fully qualified module name instead, which is unique unlike the source
+  // file name (a/util.d, b/util.d).
+  std::string name = m->toPrettyChars();
+  name += '.';
+  name += interfaceHashExt;
+  return global.params.objdir
+             ? FileName::combine(global.params.objdir, name.c_str())
+             : name;
+}
+
+std::string computeInterfaceHash(Module *m) {
+  OutBuffer buf;
+  genInterfaceText(m, &buf, willCrossModuleInline());
+
+  llvm::MD5 hasher;
+  hasher.update(llvm::StringRef(static_cast<const char *>(buf.data),
+                                buf.offset));
+  llvm::MD5::MD5Result result;
+  hasher.final(result);
+  llvm::SmallString<32> hashStr;
+  llvm::MD5::stringifyResult(result, hashStr);
+  return std::string(hashStr.str()) + "\n";
+}
+
+bool isUpToDate(const std::string &path, const std::string &contents) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  return buffer && (*buffer)->getBuffer() == contents;
+}
+
+void writeInterfaceHash(Module *m, bool sharedObj) {
+  const std::string path = getInterfaceHashPath(m, sharedObj);
+  const std::string contents = computeInterfaceHash(m);
+
+  if (isUpToDate(path, contents)) {
+    IF_LOG Logger::println("Interface hash of %s unchanged: %s", m->toChars(),
+                           path.c_str());
+    return;
+  }
+
+  IF_LOG Logger::println("Writing interface hash of %s to %s", m->toChars(),
+                         path.c_str());
+
+  auto dir = llvm::sys::path::parent_path(path);
+  if (!dir.empty()) {
+    llvm::sys::fs::create_directories(dir);
+  }
+
+#if LDC_LLVM_VER >= 306
+  std::error_code errinfo;
+  llvm::raw_fd_ostream os(path, errinfo, llvm::sys::fs::F_None);
+  if (errinfo) {
+    error(Loc(), "cannot write interface hash file '%s': %s", path.c_str(),
+          errinfo.message().c_str());
+    return;
+  }
+#else
+  std::string errinfo;
+  llvm::raw_fd_ostream os(path.c_str(), errinfo, llvm::sys::fs::F_None);
+  if (!errinfo.empty()) {
+    error(Loc(), "cannot write interface hash file '%s': %s", path.c_str(),
+          errinfo.c_str());
+    return;
+  }
+#endif
+  os << contents;
+}
+
+} // anonymous namespace
+
+void writeInterfaceHashes(Modules &modules, bool singleObj) {
+  if (!interfaceHash) {
+    return;
+  }
+
+  const bool sharedObj = singleObj && modules.dim > 1;
+  for (unsigned i = 0; i < modules.dim; i++) {
+    writeInterfaceHash(modules[i], sharedObj);
+  }
+}
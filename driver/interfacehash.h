@@ -0,0 +1,25 @@
+//===-- driver/interfacehash.h - Module interface hashes --------*- C++ -*-===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Writes a hash of the interface a module exposes to its importers
+// (-interface-hash), so that build systems can skip recompiling importers if
+// only implementation details of a module changed.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LDC_DRIVER_INTERFACEHASH_H
+#define LDC_DRIVER_INTERFACEHASH_H
+
+#include "arraytypes.h"
+
+/// Writes the interface hash files of the given (parsed) root modules if
+/// -interface-hash has been specified.
+void writeInterfaceHashes(Modules &modules, bool singleObj);
+
+#endif
@@ -25,6 +25,17 @@
 // The hash depends on the IR code (obviously), but also on the compiler+LLVM
 // versions and several compile flags (e.g. -O*, -mcpu, and -mattr).
 //
+// For `-run`, the temporary executable is cached as well, keyed by the linker
+// command line, the contents of all files passed to the linker directly
+// (object files, static libraries) and the size and modification time of the
+// libraries found via -l. If any of these libraries cannot be found in the -L
+// directories or the library directories of the linker driver, the executable
+// is not cached. A script whose object files are all recovered from the cache
+// is then run without invoking the linker at all.
+//
+// With -ir2obj-cache-prune, cache files (objects and executables) that have
+// not been used for a while are removed after compilation.
+//
 //===----------------------------------------------------------------------===//
 
 #include "driver/ir2obj_cache.h"
@@ -32,14 +43,21 @@
 #include "ddmd/errors.h"
 #include "driver/cl_options.h"
 #include "driver/ldc-version.h"
+#include "driver/toobj.h"
 #include "gen/logger.h"
 #include "gen/optimizer.h"
 
 #include "llvm/Bitcode/ReaderWriter.h"
+#if LDC_LLVM_VER >= 309
+#include "llvm/Support/CachePruning.h"
+#endif
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Program.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 
 namespace {
 
@@ -71,16 +89,130 @@ public:
   }
 };
 
-const char *cacheObjectExtension() {
-  return global.params.targetTriple->isOSWindows() ? global.obj_ext_alt
-                                                   : global.obj_ext;
+void storeCacheExecutableName(llvm::StringRef cacheExecutableHash,
+                              llvm::SmallString<128> &filePath) {
+  filePath = opts::ir2objCacheDir;
+  llvm::sys::path::append(filePath, llvm::Twine("execache_") +
+                                        cacheExecutableHash);
+  if (global.params.targetTriple->isOSWindows()) {
+    filePath += ".exe";
+  }
+}
+
+/// Hashes the contents of the given file, following symlinks.
+/// Returns false if the file could not be read.
+bool hashFileContents(llvm::StringRef fileName, llvm::raw_ostream &os) {
+  auto buffer = llvm::MemoryBuffer::getFile(fileName);
+  if (!buffer) {
+    return false;
+  }
+  os << (*buffer)->getBuffer();
+  return true;
+}
+
+/// Returns the directories searched for -l libraries: the -L directories on
+/// the linker command line, followed by the library directories reported by
+/// the gcc-compatible linker driver itself (`-print-search-dirs`).
+std::vector<std::string>
+librarySearchDirs(const std::string &linker,
+                  const std::vector<std::string> &linkerArgs) {
+  std::vector<std::string> dirs;
+  for (const auto &arg : linkerArgs) {
+    llvm::StringRef a = arg;
+    if (a.startswith("-L") && a.size() > 2) {
+      dirs.push_back(a.substr(2));
+    }
+  }
+
+  llvm::SmallString<128> outputFile;
+  if (llvm::sys::fs::createTemporaryFile("ldc-search-dirs", "txt",
+                                         outputFile)) {
+    return dirs;
+  }
+  const char *args[] = {linker.c_str(), "-print-search-dirs", nullptr};
+  llvm::StringRef empty, output = outputFile;
+  const llvm::StringRef *redirects[] = {&empty, &output, &empty};
+  const int status =
+      llvm::sys::ExecuteAndWait(linker, args, nullptr, redirects);
+  auto buffer = llvm::MemoryBuffer::getFile(outputFile);
+  llvm::sys::fs::remove(outputFile);
+  if (status != 0 || !buffer) {
+    IF_LOG Logger::println("Cannot query library directories of %s",
+                           linker.c_str());
+    return dirs;
+  }
+
+  llvm::SmallVector<llvm::StringRef, 4> lines;
+  (*buffer)->getBuffer().split(lines, "\n");
+  for (auto line : lines) {
+    const llvm::StringRef prefix = "libraries: =";
+    if (line.startswith(prefix)) {
+      llvm::SmallVector<llvm::StringRef, 16> paths;
+      line.substr(prefix.size())
+          .rtrim()
+          .split(paths, llvm::StringRef(&llvm::sys::EnvPathSeparator, 1), -1,
+                 false);
+      for (auto path : paths) {
+        dirs.push_back(path);
+      }
+    }
+  }
+  return dirs;
+}
+
+/// Resolves a -l<name> linker flag to the library file the linker would use.
+/// Returns an empty string if the library cannot be found.
+std::string findLibrary(llvm::StringRef name,
+                        const std::vector<std::string> &dirs,
+                        bool staticOnly) {
+  std::vector<std::string> fileNames;
+  if (name.startswith(":")) {
+    fileNames.push_back(name.substr(1));
+  } else {
+    if (!staticOnly) {
+      fileNames.push_back(("lib" + name + ".so").str());
+      if (global.params.targetTriple->isOSDarwin()) {
+        fileNames.push_back(("lib" + name + ".dylib").str());
+      }
+    }
+    fileNames.push_back(("lib" + name + ".a").str());
+  }
+
+  for (const auto &dir : dirs) {
+    for (const auto &fileName : fileNames) {
+      llvm::SmallString<128> path(dir);
+      llvm::sys::path::append(path, fileName);
+      if (llvm::sys::fs::is_regular_file(path)) {
+        return path.str().str();
+      }
+    }
+  }
+  return "";
+}
+
+/// Hashes the size and modification time of the given file, following
+/// symlinks. Used for the libraries found via -l, which are often large
+/// system libraries not worth reading in full for every lookup.
+/// Returns false if the file status could not be read.
+bool hashFileStatus(llvm::StringRef fileName, llvm::raw_ostream &os) {
+  llvm::sys::fs::file_status status;
+  if (llvm::sys::fs::status(fileName, status)) {
+    return false;
+  }
+  os << fileName << '\0' << status.getSize() << '\0';
+#if LDC_LLVM_VER >= 400
+  os << status.getLastModificationTime().time_since_epoch().count();
+#else
+  os << status.getLastModificationTime().toEpochTime();
+#endif
+  return true;
 }
 
 void storeCacheFileName(llvm::StringRef cacheObjectHash,
                         llvm::SmallString<128> &filePath) {
   filePath = opts::ir2objCacheDir;
   llvm::sys::path::append(filePath, llvm::Twine("ircache_") + cacheObjectHash +
-                                        "." + cacheObjectExtension());
+                                        "." + objectFileExtension());
 }
 }
 
@@ -169,4 +301,122 @@ void recoverObjectFile(llvm::StringRef cacheObjectHash,
     fatal();
   }
 }
-}
\ No newline at end of file
+
+bool calculateExecutableHash(const std::string &linker,
+                             const std::vector<std::string> &linkerArgs,
+                             llvm::StringRef outputFile,
+                             llvm::SmallString<32> &str) {
+  raw_hash_ostream hash_os;
+
+  hash_os << global.ldc_version << global.version << global.llvm_version
+          << ldc::built_with_Dcompiler_version;
+
+  const auto libDirs = librarySearchDirs(linker, linkerArgs);
+  const bool staticOnly = std::find(linkerArgs.begin(), linkerArgs.end(),
+                                    "-static") != linkerArgs.end();
+
+  for (const auto &arg : linkerArgs) {
+    // The output file is a unique temporary file for each `-run` invocation.
+    if (arg == outputFile) {
+      continue;
+    }
+    hash_os << arg << '\0';
+
+    // Let the hash depend on the contents of the object files and libraries
+    // passed to the linker directly, and on the size and modification time of
+    // the libraries found via -l.
+    if (llvm::sys::fs::is_regular_file(arg)) {
+      if (!hashFileContents(arg, hash_os)) {
+        IF_LOG Logger::println("Cannot read linker input %s", arg.c_str());
+        return false;
+      }
+    } else if (llvm::StringRef(arg).startswith("-l") && arg.size() > 2) {
+      std::string lib =
+          findLibrary(llvm::StringRef(arg).substr(2), libDirs, staticOnly);
+      if (lib.empty() || !hashFileStatus(lib, hash_os)) {
+        IF_LOG Logger::println(
+            "Cannot find library for %s, not caching the executable",
+            arg.c_str());
+        return false;
+      }
+    }
+  }
+
+  hash_os.resultAsString(str);
+  IF_LOG Logger::println("Executable hash is: %s", str.c_str());
+  return true;
+}
+
+std::string cacheExecutableLookup(llvm::StringRef cacheExecutableHash) {
+  if (opts::ir2objCacheDir.empty())
+    return "";
+
+  llvm::SmallString<128> filePath;
+  storeCacheExecutableName(cacheExecutableHash, filePath);
+  if (llvm::sys::fs::exists(filePath.c_str())) {
+    IF_LOG Logger::println("Cached executable found! %s", filePath.c_str());
+    return filePath.str().str();
+  }
+
+  IF_LOG Logger::println("Cached executable not found.");
+  return "";
+}
+
+std::string cacheExecutable(llvm::StringRef executable,
+                            llvm::StringRef cacheExecutableHash) {
+  if (opts::ir2objCacheDir.empty())
+    return "";
+
+  if (!llvm::sys::fs::exists(opts::ir2objCacheDir) &&
+      llvm::sys::fs::create_directory(opts::ir2objCacheDir)) {
+    error(Loc(), "Unable to create cache directory: %s",
+          opts::ir2objCacheDir.c_str());
+    fatal();
+  }
+
+  llvm::SmallString<128> cacheFile;
+  storeCacheExecutableName(cacheExecutableHash, cacheFile);
+
+  // Moving the freshly linked executable into the cache is atomic, so
+  // concurrent `-run` invocations never see a partially written file. If the
+  // move fails (e.g. the cache is on another file system), the executable is
+  // simply not cached.
+  IF_LOG Logger::println("Move executable to cache: %s to %s",
+                         executable.str().c_str(), cacheFile.c_str());
+  if (llvm::sys::fs::rename(executable, cacheFile.c_str())) {
+    IF_LOG Logger::println("Failed to move executable to cache.");
+    return "";
+  }
+
+  return cacheFile.str().str();
+}
+
+void pruneCache() {
+  if (!opts::ir2objCachePrune || opts::ir2objCacheDir.empty() ||
+      !llvm::sys::fs::exists(opts::ir2objCacheDir)) {
+    return;
+  }
+
+#if LDC_LLVM_VER >= 309
+  IF_LOG Logger::println("Pruning the cache %s", opts::ir2objCacheDir.c_str());
+  // Cached object files are read (through symlinks) by the linker and cached
+  // executables are run from the cache, so the file access times tell when a
+  // cache entry was last used.
+  llvm::CachePruning pruner(opts::ir2objCacheDir);
+#if LDC_LLVM_VER >= 400
+  pruner.setPruningInterval(
+      std::chrono::seconds(opts::ir2objCachePruneInterval));
+  pruner.setEntryExpiration(
+      std::chrono::seconds(opts::ir2objCachePruneExpiration));
+#else
+  pruner.setPruningInterval(opts::ir2objCachePruneInterval);
+  pruner.setEntryExpiration(opts::ir2objCachePruneExpiration);
+#endif
+  pruner.setMaxSize(opts::ir2objCachePruneMaxPercentage);
+  pruner.prune();
+#else
+  warning(Loc(), "-ir2obj-cache-prune requires LDC to be built against "
+                 "LLVM 3.9 or later; ignoring");
+#endif
+}
+}
@@ -11,6 +11,7 @@
 #define LDC_DRIVER_IR2OBJ_CACHE_H
 
 #include <string>
+#include <vector>
 
 namespace llvm {
 class Module;
@@ -24,6 +25,21 @@ void calculateModuleHash(llvm::Module *m, llvm::SmallString<32> &str);
 std::string cacheLookup(llvm::StringRef cacheObjectHash);
 void cacheObjectFile(llvm::StringRef objectFile, llvm::StringRef cacheObjectHash);
 void recoverObjectFile(llvm::StringRef cacheObjectHash, llvm::StringRef objectFile);
+
+/// Hashes the command line and inputs of the gcc-compatible linker into str.
+/// Returns false if a linker input cannot be read or a -l library cannot be
+/// found, in which case the executable must not be cached.
+bool calculateExecutableHash(const std::string &linker,
+                             const std::vector<std::string> &linkerArgs,
+                             llvm::StringRef outputFile,
+                             llvm::SmallString<32> &str);
+std::string cacheExecutableLookup(llvm::StringRef cacheExecutableHash);
+std::string cacheExecutable(llvm::StringRef executable,
+                            llvm::StringRef cacheExecutableHash);
+
+/// Removes expired cache files (objects and executables) if -ir2obj-cache-prune
+/// is enabled.
+void pruneCache();
 }
 
 #endif
@@ -0,0 +1,378 @@
+//===-- layoutreport.cpp --------------------------------------------------===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// The report covers all structs, unions and classes with a finalized layout
+// that are members of the root modules, including nested aggregates, those in
+// attribute blocks and those in template instances. Aggregates local to
+// function bodies are not included.
+//
+// Padding is reported per field (the hole before it) and at the end of a
+// struct. For classes, only the fields declared in the class itself are
+// considered; the layout starts after the base class (or the vtable and
+// monitor pointers) and the interface vtable pointers. Cache lines are counted
+// assuming an instance starts on a cache line boundary.
+//
+// The suggested field order sorts the fields by decreasing alignment, which
+// removes all holes between naturally aligned fields. It is only reported if
+// it actually reduces the size, and never for aggregates with overlapping
+// fields (unions).
+//
+//===----------------------------------------------------------------------===//
+
+#include "driver/layoutreport.h"
+
+#include "aggregate.h"
+#include "attrib.h"
+#include "declaration.h"
+#include "errors.h"
+#include "mars.h"
+#include "module.h"
+#include "mtype.h"
+#include "target.h"
+#include "template.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace cl = llvm::cl;
+
+static cl::opt<bool> vlayout(
+    "vlayout",
+    cl::desc("Print the layout of all structs and classes: field offsets, "
+             "padding, cache lines and a padding-minimizing field order"),
+    cl::ZeroOrMore);
+
+static cl::opt<std::string>
+    vlayoutJSON("vlayout-json",
+                cl::desc("Write the struct and class layout report as JSON "
+                         "to <file>"),
+                cl::value_desc("file"));
+
+namespace {
+
+const unsigned cacheLineSize = 64;
+
+struct FieldLayout {
+  VarDeclaration *var;
+  unsigned offset;
+  unsigned size;
+  unsigned alignSize;
+  unsigned paddingBefore;
+};
+
+struct AggregateLayout {
+  AggregateDeclaration *ad;
+  unsigned start; // offset of the first own field slot
+  unsigned end;   // size of the aggregate (struct) or end of the own fields
+  unsigned tailPadding;
+  unsigned padding; // total, including the tail padding
+  bool hasOverlaps;
+  std::vector<FieldLayout> fields;
+  // Empty if the declared order is already optimal.
+  std::vector<const FieldLayout *> suggestedOrder;
+  unsigned suggestedEnd;
+
+  unsigned cacheLines() const {
+    return (ad->structsize + cacheLineSize - 1) / cacheLineSize;
+  }
+};
+
+bool crossesCacheLine(const FieldLayout &f) {
+  return f.size > 0 && f.size <= cacheLineSize &&
+         f.offset / cacheLineSize != (f.offset + f.size - 1) / cacheLineSize;
+}
+
+/// Returns the size of a struct after rounding up to its alignment, as done by
+/// StructDeclaration::finalizeSize().
+unsigned roundStructSize(StructDeclaration *sd, unsigned size,
+                         unsigned alignSize) {
+  if (size == 0) {
+    return 1;
+  }
+  const unsigned align =
+      sd->alignment == STRUCTALIGN_DEFAULT ? alignSize : sd->alignment;
+  return (size + align - 1) & ~(align - 1);
+}
+
+void suggestFieldOrder(AggregateLayout &l) {
+  if (l.hasOverlaps || l.fields.size() < 2) {
+    return;
+  }
+
+  std::vector<const FieldLayout *> order;
+  for (const auto &f : l.fields) {
+    order.push_back(&f);
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [](const FieldLayout *a, const FieldLayout *b) {
+                     return a->alignSize > b->alignSize;
+                   });
+
+  unsigned nextOffset = l.start;
+  unsigned aggSize = l.start;
+  unsigned aggAlignSize = 0;
+  for (auto f : order) {
+    AggregateDeclaration::placeField(&nextOffset, f->size, f->alignSize,
+                                     f->var->alignment, &aggSize,
+                                     &aggAlignSize, false);
+  }
+  if (auto sd = l.ad->isStructDeclaration()) {
+    aggSize = roundStructSize(sd, aggSize, std::max(aggAlignSize,
+                                                    sd->alignsize));
+  }
+
+  if (aggSize < l.end) {
+    l.suggestedOrder = std::move(order);
+    l.suggestedEnd = aggSize;
+  }
+}
+
+AggregateLayout computeLayout(AggregateDeclaration *ad) {
+  AggregateLayout l;
+  l.ad = ad;
+  l.start = 0;
+  l.hasOverlaps = false;
+  l.padding = 0;
+  l.tailPadding = 0;
+  l.suggestedEnd = 0;
+
+  ClassDeclaration *cd = ad->isClassDeclaration();
+  if (cd) {
+    // Mirror ClassDeclaration::finalizeSize(): the base class (or vptr and
+    // monitor) comes first, followed by the interface vtable pointers.
+    l.start = cd->baseClass
+                  ? cd->baseClass->structsize
+                  : Target::ptrsize * (cd->isCPPclass() ? 1 : 2);
+    for (size_t i = 0; i < cd->interfaces.length; ++i) {
+      ClassDeclaration *iface = cd->interfaces.ptr[i]->sym;
+      const unsigned align = iface->alignsize ? iface->alignsize
+                                              : Target::ptrsize;
+      l.start = (l.start + align - 1) & ~(align - 1);
+      l.start += iface->structsize;
+    }
+  }
+
+  unsigned prevEnd = l.start;
+  for (auto vd : ad->fields) {
+    FieldLayout f;
+    f.var = vd;
+    f.offset = vd->offset;
+    f.size = static_cast<unsigned>(vd->type->size());
+    f.alignSize = Target::fieldalign(vd->type);
+    if (f.offset < prevEnd) {
+      l.hasOverlaps = true;
+      f.paddingBefore = 0;
+    } else {
+      f.paddingBefore = f.offset - prevEnd;
+    }
+    l.padding += f.paddingBefore;
+    prevEnd = std::max(prevEnd, f.offset + f.size);
+    l.fields.push_back(f);
+  }
+
+  if (cd) {
+    // Class instances are not rounded up to their alignment.
+    l.end = prevEnd;
+  } else {
+    l.end = ad->structsize;
+    if (ad->structsize > prevEnd) {
+      l.tailPadding = ad->structsize - prevEnd;
+      l.padding += l.tailPadding;
+    }
+  }
+
+  suggestFieldOrder(l);
+  return l;
+}
+
+/// Collects the aggregates with a finalized layout among the given members,
+/// recursing into nested scopes.
+class AggregateCollector {
+  llvm::SmallPtrSet<Dsymbol *, 32> visited;
+
+public:
+  std::vector<AggregateDeclaration *> aggregates;
+
+  void visit(Dsymbols *members) {
+    if (!members) {
+      return;
+    }
+    for (auto s : *members) {
+      visit(s);
+    }
+  }
+
+  void visit(Dsymbol *s) {
+    if (!s || s->errors || !visited.insert(s).second) {
+      return;
+    }
+
+    if (auto ad = s->isAggregateDeclaration()) {
+      if (ad->sizeok == SIZEOKdone && !ad->isInterfaceDeclaration()) {
+        aggregates.push_back(ad);
+      }
+      visit(ad->members);
+    } else if (auto attrib = s->isAttribDeclaration()) {
+      visit(attrib->include(nullptr, nullptr));
+    } else if (auto ti = s->isTemplateInstance()) {
+      if (!ti->inst || ti->inst == ti) {
+        visit(ti->members);
+      }
+    }
+  }
+};
+
+std::string escapeJSON(const char *s) {
+  std::string result;
+  for (; *s; ++s) {
+    const char c = *s;
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      result += buf;
+    } else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+void printText(llvm::raw_ostream &os, const AggregateLayout &l) {
+  AggregateDeclaration *ad = l.ad;
+  os << ad->kind() << ' ' << ad->toPrettyChars() << ": size "
+     << ad->structsize << ", alignment " << ad->alignsize << ", padding "
+     << l.padding << ", cache lines " << l.cacheLines() << '\n';
+
+  for (const auto &f : l.fields) {
+    if (f.paddingBefore) {
+      os << "  +" << (f.offset - f.paddingBefore) << "\t[" << f.paddingBefore
+         << " bytes padding]\n";
+    }
+    os << "  +" << f.offset << '\t' << f.var->toChars() << ": "
+       << f.var->type->toChars() << " (size " << f.size << ")";
+    if (crossesCacheLine(f)) {
+      os << " [crosses cache line]";
+    }
+    os << '\n';
+  }
+  if (l.tailPadding) {
+    os << "  +" << (ad->structsize - l.tailPadding) << "\t[" << l.tailPadding
+       << " bytes tail padding]\n";
+  }
+
+  if (!l.suggestedOrder.empty()) {
+    os << "  suggested order:";
+    for (auto f : l.suggestedOrder) {
+      os << ' ' << f->var->toChars();
+    }
+    os << " (saves " << (l.end - l.suggestedEnd) << " bytes)\n";
+  }
+}
+
+void printJSON(llvm::raw_ostream &os,
+               const std::vector<AggregateLayout> &layouts) {
+  os << "[";
+  bool firstAggregate = true;
+  for (const auto &l : layouts) {
+    AggregateDeclaration *ad = l.ad;
+    os << (firstAggregate ? "\n" : ",\n") << "  {\n"
+       << "    \"kind\": \"" << ad->kind() << "\",\n"
+       << "    \"name\": \"" << escapeJSON(ad->toPrettyChars()) << "\",\n"
+       << "    \"loc\": \"" << escapeJSON(ad->loc.toChars()) << "\",\n"
+       << "    \"size\": " << ad->structsize << ",\n"
+       << "    \"alignment\": " << ad->alignsize << ",\n"
+       << "    \"padding\": " << l.padding << ",\n"
+       << "    \"tailPadding\": " << l.tailPadding << ",\n"
+       << "    \"cacheLines\": " << l.cacheLines() << ",\n"
+       << "    \"fields\": [";
+    bool firstField = true;
+    for (const auto &f : l.fields) {
+      os << (firstField ? "\n" : ",\n") << "      {\"name\": \""
+         << escapeJSON(f.var->toChars()) << "\", \"type\": \""
+         << escapeJSON(f.var->type->toChars()) << "\", \"offset\": "
+         << f.offset << ", \"size\": " << f.size
+         << ", \"paddingBefore\": " << f.paddingBefore
+         << ", \"crossesCacheLine\": "
+         << (crossesCacheLine(f) ? "true" : "false") << "}";
+      firstField = false;
+    }
+    os << (firstField ? "]" : "\n    ]");
+    if (!l.suggestedOrder.empty()) {
+      os << ",\n    \"suggestedOrder\": [";
+      bool first = true;
+      for (auto f : l.suggestedOrder) {
+        os << (first ? "" : ", ") << '"' << escapeJSON(f->var->toChars())
+           << '"';
+        first = false;
+      }
+      os << "],\n    \"suggestedSavings\": " << (l.end - l.suggestedEnd);
+    }
+    os << "\n  }";
+    firstAggregate = false;
+  }
+  os << (firstAggregate ? "]\n" : "\n]\n");
+}
+
+} // anonymous namespace
+
+void writeLayoutReport(Modules &modules) {
+  if (!vlayout && vlayoutJSON.empty()) {
+    return;
+  }
+
+  AggregateCollector collector;
+  for (auto m : modules) {
+    collector.visit(m->members);
+  }
+
+  std::vector<AggregateLayout> layouts;
+  layouts.reserve(collector.aggregates.size());
+  for (auto ad : collector.aggregates) {
+    layouts.push_back(computeLayout(ad));
+  }
+
+  if (vlayout) {
+    std::string text;
+    llvm::raw_string_ostream os(text);
+    for (const auto &l : layouts) {
+      printText(os, l);
+    }
+    os.flush();
+    fputs(text.c_str(), global.stdmsg);
+  }
+
+  if (!vlayoutJSON.empty()) {
+#if LDC_LLVM_VER >= 306
+    std::error_code errinfo;
+    llvm::raw_fd_ostream os(vlayoutJSON, errinfo, llvm::sys::fs::F_Text);
+    if (errinfo) {
+      error(Loc(), "cannot write layout report '%s': %s",
+            vlayoutJSON.c_str(), errinfo.message().c_str());
+      fatal();
+    }
+#else
+    std::string errinfo;
+    llvm::raw_fd_ostream os(vlayoutJSON.c_str(), errinfo,
+                            llvm::sys::fs::F_Text);
+    if (!errinfo.empty()) {
+      error(Loc(), "cannot write layout report '%s': %s",
+            vlayoutJSON.c_str(), errinfo.c_str());
+      fatal();
+    }
+#endif
+    printJSON(os, layouts);
+  }
+}
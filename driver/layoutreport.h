@@ -0,0 +1,25 @@
+//===-- driver/layoutreport.h - Aggregate layout report ---------*- C++ -*-===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Reports the memory layout of the structs and classes declared in the root
+// modules (-vlayout, -vlayout-json): field offsets, padding, the number of
+// cache lines spanned and a field order minimizing the padding.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LDC_DRIVER_LAYOUTREPORT_H
+#define LDC_DRIVER_LAYOUTREPORT_H
+
+#include "arraytypes.h"
+
+/// Writes the layout report for the given (semantically analyzed) root
+/// modules if -vlayout or -vlayout-json has been specified.
+void writeLayoutReport(Modules &modules);
+
+#endif
@@ -13,6 +13,7 @@
 #include "root.h"
 #include "driver/cl_options.h"
 #include "driver/exe_path.h"
+#include "driver/ir2obj_cache.h"
 #include "driver/tool.h"
 #include "gen/llvm.h"
 #include "gen/logger.h"
@@ -145,6 +146,43 @@ void insertBitcodeFiles(llvm::Module &M, llvm::LLVMContext &Ctx,
 
 static std::string gExePath;
 
+// Whether gExePath refers to an executable in the ir2obj cache, which must not
+// be deleted after running it.
+static bool gExeIsCached = false;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// For `-run` with an ir2obj cache, runs an executable from the cache if one
+/// has been linked from identical inputs before. Otherwise links the
+/// executable and adds it to the cache. Executables whose linker inputs
+/// cannot all be hashed are linked without caching.
+static int linkCachedExecutable(const std::string &linker,
+                                const std::vector<std::string> &args) {
+  llvm::SmallString<32> exeHash;
+  if (!ir2obj::calculateExecutableHash(linker, args, gExePath, exeHash)) {
+    return executeToolAndWait(linker, args, global.params.verbose);
+  }
+
+  std::string cachedExe = ir2obj::cacheExecutableLookup(exeHash);
+  if (!cachedExe.empty()) {
+    // Remove the empty temporary file reserved by getOutputName().
+    llvm::sys::fs::remove(gExePath);
+    gExePath = cachedExe;
+    gExeIsCached = true;
+    return 0;
+  }
+
+  int status = executeToolAndWait(linker, args, global.params.verbose);
+  if (status == 0) {
+    cachedExe = ir2obj::cacheExecutable(gExePath, exeHash);
+    if (!cachedExe.empty()) {
+      gExePath = cachedExe;
+      gExeIsCached = true;
+    }
+  }
+  return status;
+}
+
 static int linkObjToBinaryGcc(bool sharedLib, bool fullyStatic) {
   Logger::println("*** Linking executable ***");
 
@@ -349,6 +387,10 @@ static int linkObjToBinaryGcc(bool sharedLib, bool fullyStatic) {
   }
   logstr << "\n"; // FIXME where's flush ?
 
+  if (global.params.run && !opts::ir2objCacheDir.empty()) {
+    return linkCachedExecutable(gcc, args);
+  }
+
   // try to call linker
   return executeToolAndWait(gcc, args, global.params.verbose);
 }
@@ -763,7 +805,8 @@ int createStaticLibrary() {
 //////////////////////////////////////////////////////////////////////////////
 
 void deleteExecutable() {
-  if (!gExePath.empty() && !llvm::sys::fs::is_directory(gExePath)) {
+  if (!gExePath.empty() && !gExeIsCached &&
+      !llvm::sys::fs::is_directory(gExePath)) {
     llvm::sys::fs::remove(gExePath);
   }
 }
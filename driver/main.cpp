@@ -23,8 +23,12 @@
 #include "driver/codegenerator.h"
 #include "driver/configfile.h"
 #include "driver/exe_path.h"
+#include "driver/interfacehash.h"
+#include "driver/ir2obj_cache.h"
+#include "driver/layoutreport.h"
 #include "driver/ldc-version.h"
 #include "driver/linker.h"
+#include "driver/statistics.h"
 #include "driver/targetmachine.h"
 #include "gen/cl_helpers.h"
 #include "gen/irstate.h"
@@ -301,7 +305,6 @@ static void hideLLVMOptions() {
   hide(map, "shrink-wrap");
   hide(map, "spiller");
   hide(map, "stackmap-version");
-  hide(map, "stats");
   hide(map, "strip-debug");
   hide(map, "struct-path-tbaa");
   hide(map, "time-passes");
@@ -326,6 +329,11 @@ static void hideLLVMOptions() {
   hide(map, "fdata-sections");
   hide(map, "ffunction-sections");
 
+  if (map.count("stats")) {
+    map["stats"]->setDescription(
+        "Print the compiler and LLVM statistics to stderr");
+  }
+
 #if LDC_LLVM_VER >= 307
   // LLVM 3.7 introduces compiling as shared library. The result
   // is a clash in the command line options.
@@ -1004,20 +1012,81 @@ static void dumpPredefinedVersions() {
   }
 }
 
+/// Writes the JSON descriptions of the given modules as one JSON array,
+/// streaming each module as soon as it has been generated so that the
+/// description of all modules never has to be held in memory at once.
+static void writeJsonFile(const char *filename,
+                          llvm::ArrayRef<Module *> modules, Strings *fields) {
+#if LDC_LLVM_VER >= 306
+  std::error_code errinfo;
+  llvm::raw_fd_ostream os(filename, errinfo, llvm::sys::fs::F_Text);
+  if (errinfo) {
+    error(Loc(), "cannot write JSON file '%s': %s", filename,
+          errinfo.message().c_str());
+    return;
+  }
+#else
+  std::string errinfo;
+  llvm::raw_fd_ostream os(filename, errinfo, llvm::sys::fs::F_Text);
+  if (!errinfo.empty()) {
+    error(Loc(), "cannot write JSON file '%s': %s", filename,
+          errinfo.c_str());
+    return;
+  }
+#endif
+
+  os << "[\n";
+  bool first = true;
+  for (auto m : modules) {
+    if (global.params.verbose) {
+      fprintf(global.stdmsg, "json gen %s\n", m->toChars());
+    }
+    OutBuffer buf;
+    json_generate_module(&buf, m, fields);
+    if (!first) {
+      os << ",\n";
+    }
+    os.write(reinterpret_cast<const char *>(buf.data), buf.offset);
+    first = false;
+  }
+  os << "\n]\n";
+}
+
 /// Emits the .json AST description file.
 ///
 /// This (ugly) piece of code has been taken from DMD's mars.c and should be
 /// kept in sync with the former.
+///
+/// With -Xd, one file per module is written in addition; the combined file is
+/// then only written if requested via -X or -Xf.
 static void emitJson(Modules &modules) {
-  OutBuffer buf;
-  json_generate(&buf, &modules);
+  Strings fields;
+  for (const auto &field : jsonFields) {
+    fields.push(field.c_str());
+  }
+  Strings *const fieldsFilter = jsonFields.empty() ? nullptr : &fields;
+
+  if (!jsonDir.empty()) {
+    // One file per module, named after the fully qualified module name.
+    for (auto m : modules) {
+      std::string name = m->toPrettyChars();
+      name += '.';
+      name += global.json_ext;
+      const char *jsonfilename =
+          FileName::combine(jsonDir.c_str(), name.c_str());
+      ensurePathToNameExists(Loc(), jsonfilename);
+      writeJsonFile(jsonfilename, m, fieldsFilter);
+    }
+    if (!global.params.doJsonGeneration) {
+      return;
+    }
+  }
 
-  // Write buf to file
   const char *name = global.params.jsonfilename;
 
   if (name && name[0] == '-' &&
-      name[1] == 0) { // Write to stdout; assume it succeeds
-    (void)fwrite(buf.data, 1, buf.offset, stdout);
+      name[1] == 0) { // Write to stdout
+    writeJsonFile("-", {modules.data, modules.dim}, fieldsFilter);
   } else {
     /* The filename generation code here should be harmonized with
      * Module::setOutfile()
@@ -1039,11 +1108,7 @@ static void emitJson(Modules &modules) {
 
     ensurePathToNameExists(Loc(), jsonfilename);
 
-    auto jsonfile = File::create(jsonfilename);
-
-    jsonfile->setbuffer(buf.data, buf.offset);
-    jsonfile->ref = 1;
-    writeFile(Loc(), jsonfile);
+    writeJsonFile(jsonfilename, {modules.data, modules.dim}, fieldsFilter);
   }
 }
 
@@ -1074,6 +1139,7 @@ int cppmain(int argc, char **argv) {
   bool helpOnly;
   Strings files;
   parseCommandLine(argc, argv, files, helpOnly);
+  initStatistics();
 
   if (files.dim == 0 && !helpOnly) {
     cl::PrintHelpMessage();
@@ -1303,6 +1369,7 @@ int cppmain(int argc, char **argv) {
   }
 
   // Read files, parse them
+  startPhase("parse");
   for (unsigned i = 0; i < modules.dim; i++) {
     Module *m = modules[i];
     if (global.params.verbose) {
@@ -1349,11 +1416,13 @@ int cppmain(int argc, char **argv) {
       genhdrfile(modules[i]);
     }
   }
+  writeInterfaceHashes(modules, singleObj);
   if (global.errors) {
     fatal();
   }
 
   // load all unconditional imports for better symbol resolving
+  startPhase("semantic");
   for (unsigned i = 0; i < modules.dim; i++) {
     if (global.params.verbose) {
       fprintf(global.stdmsg, "importall %s\n", modules[i]->toChars());
@@ -1410,7 +1479,10 @@ int cppmain(int argc, char **argv) {
   // the user requested it.
   writeModuleDependencyFile();
 
+  writeLayoutReport(modules);
+
   // Generate one or more object/IR/bitcode files.
+  startPhase("codegen");
   if (global.params.obj && !modules.empty()) {
     ldc::CodeGenerator cg(getGlobalContext(), singleObj);
 
@@ -1437,6 +1509,7 @@ int cppmain(int argc, char **argv) {
   }
 
   // Generate DDoc output files.
+  startPhase("docs");
   if (global.params.doDocComments) {
     for (unsigned i = 0; i < modules.dim; i++) {
       gendocfile(modules[i]);
@@ -1444,10 +1517,12 @@ int cppmain(int argc, char **argv) {
   }
 
   // Generate the AST-describing JSON file.
-  if (global.params.doJsonGeneration) {
+  if (global.params.doJsonGeneration || !jsonDir.empty()) {
     emitJson(modules);
   }
 
+  printStatistics();
+
   freeRuntime();
   llvm::llvm_shutdown();
 
@@ -1482,5 +1557,7 @@ int cppmain(int argc, char **argv) {
     }
   }
 
+  ir2obj::pruneCache();
+
   return status;
 }
@@ -0,0 +1,180 @@
+//===-- statistics.cpp ----------------------------------------------------===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// The LLVM statistics (-stats) are only collected if LLVM itself has been
+// built with assertions or LLVM_ENABLE_STATS; the LDC counters are always
+// available.
+//
+//===----------------------------------------------------------------------===//
+
+#include "driver/statistics.h"
+
+#include "errors.h"
+#include "mars.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
+#include <string>
+#include <vector>
+#if LDC_POSIX
+#include <sys/resource.h>
+#endif
+
+namespace cl = llvm::cl;
+
+static cl::opt<std::string> statsFile(
+    "stats-file",
+    cl::desc("Write the compiler statistics as JSON to <file>"),
+    cl::value_desc("file"));
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Phase {
+  const char *name;
+  Clock::time_point start;
+};
+
+/// The compiler phases started so far; each one ends where the next starts.
+std::vector<Phase> phases;
+
+struct Counter {
+  const char *name;
+  const char *desc;
+  uint64_t value;
+};
+
+std::vector<Counter> getCounters() {
+  const Statistics &s = global.stats;
+  return {
+      {"modules-loaded", "Number of imported modules loaded", s.modulesLoaded},
+      {"tokens-lexed", "Number of tokens lexed", s.tokensLexed},
+      {"template-instances-created", "Number of template instances created",
+       s.templateInstancesCreated},
+      {"template-instances-reused",
+       "Number of template instantiations resolved to an existing instance",
+       s.templateInstancesReused},
+      {"ctfe-calls", "Number of functions interpreted by CTFE", s.ctfeCalls},
+      {"functions-codegenned", "Number of function definitions emitted",
+       s.functionsCodegenned},
+      {"typeinfos-emitted", "Number of TypeInfo definitions emitted",
+       s.typeInfosEmitted},
+      {"inlining-candidates",
+       "Number of functions defined for cross-module inlining",
+       s.inliningCandidates},
+      {"gagged-errors", "Number of gagged errors discarded without formatting",
+       s.gaggedErrors},
+      {"speller-searches-skipped",
+       "Number of spelling suggestion searches skipped for gagged errors",
+       s.spellerSearchesSkipped},
+      {"template-functions-pruned",
+       "Number of unreferenced template functions not emitted",
+       s.templateFunctionsPruned},
+  };
+}
+
+void printText(llvm::raw_ostream &os) {
+  os << "===" << std::string(73, '-') << "===\n"
+     << "                          ... LDC statistics ...\n"
+     << "===" << std::string(73, '-') << "===\n\n";
+  for (const auto &c : getCounters()) {
+    os << llvm::format("%12llu ", static_cast<unsigned long long>(c.value))
+       << "ldc - " << c.desc << '\n';
+  }
+  os << '\n';
+}
+
+/// Returns the peak resident set size of the compiler process in bytes, or 0
+/// if unknown.
+uint64_t getPeakMemoryUsage() {
+#if LDC_POSIX
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if __APPLE__
+    return usage.ru_maxrss; // bytes
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // kilobytes
+#endif
+  }
+#endif
+  return 0;
+}
+
+void printJSON(llvm::raw_ostream &os) {
+  os << "{\n  \"ldc\": {";
+  bool first = true;
+  for (const auto &c : getCounters()) {
+    os << (first ? "\n" : ",\n") << "    \"" << c.name << "\": " << c.value;
+    first = false;
+  }
+  os << "\n  }";
+
+  // The wall time of each phase in seconds. The last phase ends now.
+  const auto end = Clock::now();
+  os << ",\n  \"phases\": {";
+  for (size_t i = 0; i < phases.size(); ++i) {
+    const auto phaseEnd = i + 1 < phases.size() ? phases[i + 1].start : end;
+    const std::chrono::duration<double> seconds = phaseEnd - phases[i].start;
+    os << (i ? ",\n" : "\n") << "    \"" << phases[i].name
+       << "\": " << llvm::format("%.6f", seconds.count());
+  }
+  os << "\n  }";
+
+  if (uint64_t peakMemory = getPeakMemoryUsage()) {
+    os << ",\n  \"peak-memory\": " << peakMemory;
+  }
+#if LDC_LLVM_VER >= 400
+  os << ",\n  \"llvm\": ";
+  llvm::PrintStatisticsJSON(os);
+#endif
+  os << "\n}\n";
+}
+
+} // anonymous namespace
+
+void initStatistics() {
+#if LDC_LLVM_VER >= 400
+  // LLVM only registers the statistics while they are enabled.
+  if (!statsFile.empty()) {
+    llvm::EnableStatistics(/*PrintOnExit=*/false);
+  }
+#endif
+}
+
+void startPhase(const char *name) { phases.push_back({name, Clock::now()}); }
+
+void printStatistics() {
+  if (!statsFile.empty()) {
+#if LDC_LLVM_VER >= 306
+    std::error_code errinfo;
+    llvm::raw_fd_ostream os(statsFile, errinfo, llvm::sys::fs::F_Text);
+    if (errinfo) {
+      error(Loc(), "cannot write statistics file '%s': %s", statsFile.c_str(),
+            errinfo.message().c_str());
+      return;
+    }
+#else
+    std::string errinfo;
+    llvm::raw_fd_ostream os(statsFile.c_str(), errinfo, llvm::sys::fs::F_Text);
+    if (!errinfo.empty()) {
+      error(Loc(), "cannot write statistics file '%s': %s", statsFile.c_str(),
+            errinfo.c_str());
+      return;
+    }
+#endif
+    printJSON(os);
+  } else if (llvm::AreStatisticsEnabled()) {
+    // The LLVM statistics are printed upon llvm_shutdown().
+    printText(llvm::errs());
+  }
+}
@@ -0,0 +1,32 @@
+//===-- driver/statistics.h - Compiler statistics ---------------*- C++ -*-===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Reports the frontend and glue layer counters collected in global.stats,
+// together with the LLVM statistics, when requested via -stats or
+// -stats-file. The stats file also contains the wall time spent in each
+// compiler phase and the peak memory usage of the compiler process.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LDC_DRIVER_STATISTICS_H
+#define LDC_DRIVER_STATISTICS_H
+
+/// Enables the collection of LLVM statistics if requested. Must be called
+/// before any LLVM passes are run.
+void initStatistics();
+
+/// Marks the start of the given compiler phase (and the end of the previous
+/// one) for the phase timings in the -stats-file.
+void startPhase(const char *name);
+
+/// Prints the collected statistics to stderr or writes them to the
+/// -stats-file. Must be called before llvm_shutdown().
+void printStatistics();
+
+#endif
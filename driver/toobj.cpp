@@ -40,6 +40,10 @@
 #include "llvm/Target/TargetSubtargetInfo.h"
 #endif
 #include "llvm/IR/Module.h"
+#if LDC_LLVM_VER >= 309
+#include "llvm/CodeGen/ParallelCG.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#endif
 #include <cstddef>
 #include <fstream>
 
@@ -55,6 +59,12 @@ static llvm::cl::opt<bool>
     NoIntegratedAssembler("no-integrated-as", llvm::cl::Hidden,
                           llvm::cl::desc("Disable integrated assembler"));
 
+static llvm::cl::opt<unsigned> CodegenPartitions(
+    "codegen-partitions",
+    llvm::cl::desc("Split each optimized module into <N> partitions and "
+                   "generate their machine code in parallel (experimental)"),
+    llvm::cl::value_desc("N"), llvm::cl::init(1));
+
 // based on llc code, University of Illinois Open Source License
 static void codegenModule(llvm::TargetMachine &Target, llvm::Module &m,
                           llvm::raw_fd_ostream &out,
@@ -106,15 +116,8 @@ static void codegenModule(llvm::TargetMachine &Target, llvm::Module &m,
   Passes.run(m);
 }
 
-static void assemble(const std::string &asmpath, const std::string &objpath) {
-  std::vector<std::string> args;
-  args.push_back("-O3");
-  args.push_back("-c");
-  args.push_back("-xassembler");
-  args.push_back(asmpath);
-  args.push_back("-o");
-  args.push_back(objpath);
-
+/// Adds the flags selecting the target variant to a GCC command line.
+static void addTargetFlags(std::vector<std::string> &args) {
   // Only specify -m32/-m64 for architectures where the two variants actually
   // exist (as e.g. the GCC ARM toolchain doesn't recognize the switches).
   // MIPS does not have -m32/-m64 but requires -mabi=.
@@ -154,6 +157,18 @@ static void assemble(const std::string &asmpath, const std::string &objpath) {
       }
     }
   }
+}
+
+static void assemble(const std::string &asmpath, const std::string &objpath) {
+  std::vector<std::string> args;
+  args.push_back("-O3");
+  args.push_back("-c");
+  args.push_back("-xassembler");
+  args.push_back(asmpath);
+  args.push_back("-o");
+  args.push_back(objpath);
+
+  addTargetFlags(args);
 
   // Run the compiler to assembly the program.
   std::string gcc(getGcc());
@@ -166,8 +181,16 @@ static void assemble(const std::string &asmpath, const std::string &objpath) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const char *objectFileExtension() {
+  return global.params.targetTriple->isOSWindows() ? global.obj_ext_alt
+                                                   : global.obj_ext;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 namespace {
 using namespace llvm;
+
 static void printDebugLoc(const DebugLoc &debugLoc, formatted_raw_ostream &os) {
   os << debugLoc.getLine() << ":" << debugLoc.getCol();
 #if LDC_LLVM_VER >= 307
@@ -363,6 +386,112 @@ void writeObjectFile(llvm::Module *m, std::string &filename) {
     }
   }
 }
+
+/// Returns whether the machine code is to be generated in partitions as
+/// requested by -codegen-partitions. Warns once if that is not supported.
+bool usePartitionedCodegen() {
+  if (CodegenPartitions <= 1) {
+    return false;
+  }
+
+  const char *reason = nullptr;
+#if LDC_LLVM_VER >= 309
+  // Combining partial objects requires a GCC-compatible linker driver.
+  if (global.params.targetTriple->isWindowsMSVCEnvironment()) {
+    reason = "is not supported for MSVC targets";
+  }
+#else
+  reason = "requires LLVM 3.9 or later";
+#endif
+  if (!reason) {
+    return true;
+  }
+
+  static bool warned = false;
+  if (!warned) {
+    warning(Loc(), "-codegen-partitions %s; generating machine code in a "
+                   "single partition",
+            reason);
+    warned = true;
+  }
+  return false;
+}
+
+#if LDC_LLVM_VER >= 309
+/// Combines the given object files into one relocatable object file.
+void combineObjectFiles(const std::vector<std::string> &objfiles,
+                        const std::string &filename) {
+  std::vector<std::string> args;
+  args.push_back("-r");
+  args.push_back("-nostdlib");
+  args.insert(args.end(), objfiles.begin(), objfiles.end());
+  args.push_back("-o");
+  args.push_back(filename);
+
+  addTargetFlags(args);
+
+  std::string gcc(getGcc());
+  int R = executeToolAndWait(gcc, args, global.params.verbose);
+  if (R) {
+    error(Loc(), "Error while combining partial object files.");
+    fatal();
+  }
+}
+
+/// Splits the module into `numParts` partitions, keeping COMDAT groups
+/// together, and generates the machine code for them in parallel. The
+/// partial object files are combined into `filename`.
+void writeObjectFileParallel(llvm::Module *m, std::string &filename,
+                             unsigned numParts) {
+  IF_LOG Logger::println("Writing object file in %u partitions to: %s",
+                         numParts, filename.c_str());
+
+  std::vector<std::string> partFiles;
+  std::vector<std::unique_ptr<llvm::raw_fd_ostream>> partStreams;
+  std::vector<llvm::raw_pwrite_stream *> partStreamPtrs;
+  for (unsigned i = 0; i < numParts; ++i) {
+    int fd;
+    llvm::SmallString<128> partFile;
+    if (auto ec = llvm::sys::fs::createTemporaryFile(
+            "ldc-part", objectFileExtension(), fd, partFile)) {
+      error(Loc(), "cannot create partial object file: %s",
+            ec.message().c_str());
+      fatal();
+    }
+    partFiles.push_back(partFile.str());
+    partStreams.emplace_back(new llvm::raw_fd_ostream(fd, true));
+    partStreamPtrs.push_back(partStreams.back().get());
+  }
+
+  // Each partition is code-generated in its own LLVMContext by a separate
+  // TargetMachine configured like the global one.
+  auto createTargetMachine = []() {
+    const llvm::TargetMachine &tm = *gTargetMachine;
+    return std::unique_ptr<llvm::TargetMachine>(
+        tm.getTarget().createTargetMachine(
+            tm.getTargetTriple().str(), tm.getTargetCPU(),
+            tm.getTargetFeatureString(), tm.Options, tm.getRelocationModel(),
+            tm.getCodeModel(), tm.getOptLevel()));
+  };
+
+  // splitCodeGen() consumes the module; the IRState still owns `m`.
+  // Module-local symbols (string literals, failure stubs, ...) are kept local
+  // by placing them in the partition of their users; externalizing them would
+  // make the identically named locals of different modules clash at link
+  // time.
+  llvm::splitCodeGen(llvm::CloneModule(m), partStreamPtrs, {},
+                     createTargetMachine,
+                     llvm::TargetMachine::CGFT_ObjectFile,
+                     /*PreserveLocals=*/true);
+  partStreams.clear();
+
+  combineObjectFiles(partFiles, filename);
+
+  for (const auto &partFile : partFiles) {
+    llvm::sys::fs::remove(partFile);
+  }
+}
+#endif
 } // end of anonymous namespace
 
 void writeModule(llvm::Module *m, std::string filename) {
@@ -466,7 +595,13 @@ void writeModule(llvm::Module *m, std::string filename) {
   }
 
   if (global.params.output_o && !assembleExternally) {
-    writeObjectFile(m, filename);
+    if (usePartitionedCodegen()) {
+#if LDC_LLVM_VER >= 309
+      writeObjectFileParallel(m, filename, CodegenPartitions);
+#endif
+    } else {
+      writeObjectFile(m, filename);
+    }
     if (useIR2ObjCache) {
       ir2obj::cacheObjectFile(filename, moduleHash);
     }
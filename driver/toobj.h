@@ -22,4 +22,7 @@ class Module;
 
 void writeModule(llvm::Module *m, std::string filename);
 
+/// Returns the extension of object files for the target, without the dot.
+const char *objectFileExtension();
+
 #endif
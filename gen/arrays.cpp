@@ -338,42 +338,89 @@ static void DtoSetArray(DValue *array, LLValue *dim, LLValue *ptr) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-LLConstant *DtoConstArrayInitializer(ArrayInitializer *arrinit,
-                                     Type *targetType) {
-  IF_LOG Logger::println("DtoConstArrayInitializer: %s | %s",
-                         arrinit->toChars(), targetType->toChars());
-  LOG_SCOPE;
+namespace {
+/// Returns whether arrays of `elemty` can be emitted as ConstantDataArray
+/// straight from the integer values of the frontend.
+bool isDenseElementType(Type *elemty) {
+  Type *t = elemty->toBasetype();
+  if (!t->isintegral() || t->ty == Tvector) {
+    return false;
+  }
+  const auto size = t->size();
+  return size == 1 || size == 2 || size == 4 || size == 8;
+}
 
-  assert(arrinit->value.dim == arrinit->index.dim);
+/// Returns whether `e` is an integer literal that can be stored as element of
+/// type `elemty` without any conversion.
+bool isDenseElement(Expression *e, Type *elemty) {
+  return e && e->op == TOKint64 &&
+         e->type->toBasetype()->ty == elemty->toBasetype()->ty;
+}
 
-  // get base array type
-  Type *arrty = targetType->toBasetype();
-  size_t arrlen = arrinit->dim;
+template <typename T>
+llvm::Constant *getDenseArray(const std::vector<uint64_t> &values) {
+  std::vector<T> data(values.begin(), values.end());
+  return llvm::ConstantDataArray::get(gIR->context(), data);
+}
 
-  // for statis arrays, dmd does not include any trailing default
-  // initialized elements in the value/index lists
-  if (arrty->ty == Tsarray) {
-    TypeSArray *tsa = static_cast<TypeSArray *>(arrty);
-    arrlen = static_cast<size_t>(tsa->dim->toInteger());
+/// Builds the constant for an array of the dense element type `elemty` with
+/// the given values, without creating an LLVM constant per element (large
+/// tables would otherwise cost a lot of compile time and memory).
+llvm::Constant *buildDenseArray(Type *elemty,
+                                const std::vector<uint64_t> &values) {
+  switch (elemty->toBasetype()->size()) {
+  case 1:
+    return getDenseArray<uint8_t>(values);
+  case 2:
+    return getDenseArray<uint16_t>(values);
+  case 4:
+    return getDenseArray<uint32_t>(values);
+  case 8:
+    return getDenseArray<uint64_t>(values);
+  default:
+    llvm_unreachable("Unexpected dense array element size");
   }
+}
 
-  // make sure the number of initializers is sane
-  if (arrinit->index.dim > arrlen || arrinit->dim > arrlen) {
-    error(arrinit->loc, "too many initializers, %llu, for array[%llu]",
-          static_cast<unsigned long long>(arrinit->index.dim),
-          static_cast<unsigned long long>(arrlen));
-    fatal();
+/// Tries to build the constant for an array initializer consisting only of
+/// integer literals. Returns null if that isn't possible (or there are
+/// errors to diagnose).
+llvm::Constant *tryDenseArrayInitializer(ArrayInitializer *arrinit,
+                                         Type *elemty, size_t arrlen) {
+  if (!isDenseElementType(elemty)) {
+    return nullptr;
   }
 
-  // get elem type
-  Type *elemty;
-  if (arrty->ty == Tvector) {
-    elemty = static_cast<TypeVector *>(arrty)->elementType();
-  } else {
-    elemty = arrty->nextOf();
+  Expression *defaultInit = elemty->defaultInit(arrinit->loc);
+  if (!isDenseElement(defaultInit, elemty)) {
+    return nullptr;
   }
-  LLType *llelemty = DtoMemType(elemty);
 
+  std::vector<uint64_t> values(arrlen, defaultInit->toInteger());
+  std::vector<bool> initialized(arrlen, false);
+  size_t j = 0;
+  for (size_t i = 0; i < arrinit->index.dim; i++) {
+    if (auto idx = static_cast<Expression *>(arrinit->index.data[i])) {
+      j = idx->toInteger();
+    }
+    auto val = static_cast<Initializer *>(arrinit->value.data[i]);
+    ExpInitializer *ei = val->isExpInitializer();
+    if (j >= arrlen || initialized[j] || !ei ||
+        !isDenseElement(ei->exp, elemty)) {
+      return nullptr;
+    }
+    values[j] = ei->exp->toInteger();
+    initialized[j] = true;
+    j++;
+  }
+
+  return buildDenseArray(elemty, values);
+}
+
+/// Builds the constant for an array initializer element by element.
+LLConstant *buildArrayInitializer(ArrayInitializer *arrinit, Type *arrty,
+                                  Type *elemty, LLType *llelemty,
+                                  size_t arrlen) {
   // true if array elements differ in type, can happen with array of unions
   bool mismatch = false;
 
@@ -439,17 +486,59 @@ LLConstant *DtoConstArrayInitializer(ArrayInitializer *arrinit,
     initvals[i] = elemDefaultInit;
   }
 
-  LLConstant *constarr;
   if (mismatch) {
-    constarr = LLConstantStruct::getAnon(gIR->context(),
-                                         initvals); // FIXME should this pack?
+    return LLConstantStruct::getAnon(gIR->context(),
+                                     initvals); // FIXME should this pack?
+  }
+  if (arrty->ty == Tvector) {
+    return llvm::ConstantVector::get(initvals);
+  }
+  return LLConstantArray::get(LLArrayType::get(llelemty, arrlen), initvals);
+}
+} // anonymous namespace
+
+LLConstant *DtoConstArrayInitializer(ArrayInitializer *arrinit,
+                                     Type *targetType) {
+  IF_LOG Logger::println("DtoConstArrayInitializer: %s | %s",
+                         arrinit->toChars(), targetType->toChars());
+  LOG_SCOPE;
+
+  assert(arrinit->value.dim == arrinit->index.dim);
+
+  // get base array type
+  Type *arrty = targetType->toBasetype();
+  size_t arrlen = arrinit->dim;
+
+  // for statis arrays, dmd does not include any trailing default
+  // initialized elements in the value/index lists
+  if (arrty->ty == Tsarray) {
+    TypeSArray *tsa = static_cast<TypeSArray *>(arrty);
+    arrlen = static_cast<size_t>(tsa->dim->toInteger());
+  }
+
+  // make sure the number of initializers is sane
+  if (arrinit->index.dim > arrlen || arrinit->dim > arrlen) {
+    error(arrinit->loc, "too many initializers, %llu, for array[%llu]",
+          static_cast<unsigned long long>(arrinit->index.dim),
+          static_cast<unsigned long long>(arrlen));
+    fatal();
+  }
+
+  // get elem type
+  Type *elemty;
+  if (arrty->ty == Tvector) {
+    elemty = static_cast<TypeVector *>(arrty)->elementType();
   } else {
-    if (arrty->ty == Tvector) {
-      constarr = llvm::ConstantVector::get(initvals);
-    } else {
-      constarr =
-          LLConstantArray::get(LLArrayType::get(llelemty, arrlen), initvals);
-    }
+    elemty = arrty->nextOf();
+  }
+  LLType *llelemty = DtoMemType(elemty);
+
+  LLConstant *constarr = nullptr;
+  if (arrty->ty != Tvector) {
+    constarr = tryDenseArrayInitializer(arrinit, elemty, arrlen);
+  }
+  if (!constarr) {
+    constarr = buildArrayInitializer(arrinit, arrty, elemty, llelemty, arrlen);
   }
 
   //     std::cout << "constarr: " << *constarr << std::endl;
@@ -514,6 +603,23 @@ bool isConstLiteral(ArrayLiteralExp *ale) {
 ////////////////////////////////////////////////////////////////////////////////
 
 llvm::Constant *arrayLiteralToConst(IRState *p, ArrayLiteralExp *ale) {
+  // Fast path for literals of integers, e.g., large tables generated by CTFE.
+  Type *elemty = ale->type->toBasetype()->nextOf();
+  if (ale->elements->dim && elemty && isDenseElementType(elemty)) {
+    std::vector<uint64_t> values;
+    values.reserve(ale->elements->dim);
+    for (unsigned i = 0; i < ale->elements->dim; ++i) {
+      Expression *e = indexArrayLiteral(ale, i);
+      if (!isDenseElement(e, elemty)) {
+        break;
+      }
+      values.push_back(e->toInteger());
+    }
+    if (values.size() == ale->elements->dim) {
+      return buildDenseArray(elemty, values);
+    }
+  }
+
   // Build the initializer. We have to take care as due to unions in the
   // element types (with different fields being initialized), we can end up
   // with different types for the initializer values. In this case, we
@@ -1189,12 +1295,8 @@ void DtoIndexBoundsCheck(Loc &loc, DValue *arr, DValue *index) {
 }
 
 void DtoBoundsCheckFailCall(IRState *irs, Loc &loc) {
-  llvm::Function *errorfn =
-      getRuntimeFunction(loc, irs->module, "_d_arraybounds");
-  irs->CreateCallOrInvoke(
-      errorfn, DtoModuleFileName(irs->func()->decl->getModule(), loc),
-      DtoConstUint(loc.linnum));
-
-  // the function does not return
-  irs->ir->CreateUnreachable();
+  auto file = llvm::cast<LLConstant>(
+      DtoModuleFileName(irs->func()->decl->getModule(), loc));
+  LLValue *line = DtoConstUint(loc.linnum);
+  DtoFailureCall(loc, "_d_arraybounds", file, 0, line);
 }
@@ -21,6 +21,7 @@
 #include "id.h"
 #include "ldcbindings.h"
 #include "gen/llvmhelpers.h" // printLabelName
+#include "llvm/ADT/DenseMap.h"
 #include <cctype>
 
 #ifndef ASM_X86_64
@@ -2010,6 +2011,11 @@ static Token eof_tok;
 static Expression *Handled;
 static Identifier *ident_seg;
 
+// Opcodes and registers by identifier, filled from opData/regInfo on first
+// use. Identifiers are unique, so they can be looked up by pointer.
+static llvm::DenseMap<Identifier *, AsmOp> opcodeMap;
+static llvm::DenseMap<Identifier *, Reg> regMap;
+
 struct AsmProcessor {
   typedef struct {
     int inBracket;
@@ -2064,9 +2070,15 @@ struct AsmProcessor {
         if ((i <= Reg_ST || i > Reg_ST7) && i != Reg_EFLAGS) {
           regInfo[i].ident =
               Identifier::idPool(regInfo[i].name.data(), regInfo[i].name.size());
+          regMap.insert({regInfo[i].ident, static_cast<Reg>(i)});
         }
       }
 
+      for (const auto &ent : opData) {
+        opcodeMap[Identifier::idPool(ent.inMnemonic,
+                                     std::strlen(ent.inMnemonic))] = ent.asmOp;
+      }
+
       for (int i = 0; i < N_PtrNames; i++) {
         ptrTypeIdentTable[i] = Identifier::idPool(ptrTypeNameTable[i],
                                                   std::strlen(ptrTypeNameTable[i]));
@@ -2132,8 +2144,6 @@ struct AsmProcessor {
   }
 
   AsmOp parseOpcode() {
-    static const int N_ents = sizeof(opData) / sizeof(AsmOpEnt);
-
     switch (token->value) {
     case TOKalign:
       nextToken();
@@ -2159,26 +2169,15 @@ struct AsmProcessor {
     }
 
     opIdent = token->ident;
-    const char *opcode = token->ident->string;
 
     nextToken();
 
-    // %% okay to use bsearch?
-    int i = 0, j = N_ents, k, l;
-    do {
-      k = (i + j) / 2;
-      l = strcmp(opcode, opData[k].inMnemonic);
-      if (!l) {
-        return opData[k].asmOp;
-      }
-      if (l < 0) {
-        j = k;
-      } else {
-        i = k + 1;
-      }
-    } while (i != j);
+    auto it = opcodeMap.find(opIdent);
+    if (it != opcodeMap.end()) {
+      return it->second;
+    }
 
-    stmt->error("unknown opcode '%s'", opcode);
+    stmt->error("unknown opcode '%s'", opIdent->string);
 
     return Op_Invalid;
   }
@@ -3756,47 +3755,47 @@ struct AsmProcessor {
 
       // check for reg first then dotexp is an error?
       if (e->op == TOKidentifier) {
-        for (int i = 0; i < N_Regs; i++) {
-          if (ident == regInfo[i].ident) {
-            if (static_cast<Reg>(i) == Reg_ST && token->value == TOKlparen) {
-              nextToken();
-              switch (token->value) {
-              case TOKint32v:
-              case TOKuns32v:
-              case TOKint64v:
-              case TOKuns64v:
-                if (token->uns64value < 8) {
-                  e = newRegExp(static_cast<Reg>(Reg_ST + token->uns64value));
-                } else {
-                  stmt->error("invalid floating point register index");
-                  e = Handled;
-                }
-                nextToken();
-                if (token->value == TOKrparen) {
-                  nextToken();
-                } else {
-                  stmt->error("expected ')'");
-                }
-                return e;
-              default:
-                break;
+        auto reg = regMap.find(ident);
+        if (reg != regMap.end()) {
+          const int i = reg->second;
+          if (static_cast<Reg>(i) == Reg_ST && token->value == TOKlparen) {
+            nextToken();
+            switch (token->value) {
+            case TOKint32v:
+            case TOKuns32v:
+            case TOKint64v:
+            case TOKuns64v:
+              if (token->uns64value < 8) {
+                e = newRegExp(static_cast<Reg>(Reg_ST + token->uns64value));
+              } else {
+                stmt->error("invalid floating point register index");
+                e = Handled;
               }
-              invalidExpression();
-              return Handled;
-            }
-            if (token->value == TOKcolon) {
               nextToken();
-              if (operand->segmentPrefix != Reg_Invalid) {
-                stmt->error("too many segment prefixes");
-              } else if (i >= Reg_CS && i <= Reg_GS) {
-                operand->segmentPrefix = static_cast<Reg>(i);
+              if (token->value == TOKrparen) {
+                nextToken();
               } else {
-                stmt->error("'%s' is not a segment register", ident->string);
+                stmt->error("expected ')'");
               }
-              return parseAsmExp();
+              return e;
+            default:
+              break;
+            }
+            invalidExpression();
+            return Handled;
+          }
+          if (token->value == TOKcolon) {
+            nextToken();
+            if (operand->segmentPrefix != Reg_Invalid) {
+              stmt->error("too many segment prefixes");
+            } else if (i >= Reg_CS && i <= Reg_GS) {
+              operand->segmentPrefix = static_cast<Reg>(i);
+            } else {
+              stmt->error("'%s' is not a segment register", ident->string);
             }
-            return newRegExp(static_cast<Reg>(i));
+            return parseAsmExp();
           }
+          return newRegExp(static_cast<Reg>(i));
         }
       }
 
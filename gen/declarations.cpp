@@ -106,6 +106,21 @@ bool isSpeculativeType(Type *t) {
   t->accept(&v);
   return v.result;
 }
+
+/// Returns whether the definition of the given function may be postponed
+/// until something references it (-prune-unreferenced). Module constructors,
+/// destructors and unit tests are only referenced through the ModuleInfo;
+/// nested functions are defined along with their parent.
+bool isDeferrable(FuncDeclaration *fd) {
+  if (!fd->isInstantiated() || fd->linkage != LINKd || fd->isExport()) {
+    return false;
+  }
+  if (fd->isStaticCtorDeclaration() || fd->isStaticDtorDeclaration() ||
+      fd->isUnitTestDeclaration()) {
+    return false;
+  }
+  return !getParentFunc(fd, false);
+}
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -211,8 +226,10 @@ public:
     initZ->setInitializer(ir->getDefaultInit());
     setLinkage(decl, initZ);
 
-    // emit typeinfo
-    DtoTypeInfoOf(decl->type);
+    // emit typeinfo (otherwise emitted when referenced)
+    if (!irs->pruneUnreferenced) {
+      DtoTypeInfoOf(decl->type);
+    }
 
     // Emit __xopEquals/__xopCmp/__xtoHash.
     if (decl->xeq && decl->xeq != decl->xerreq) {
@@ -405,9 +422,19 @@ public:
 
   void visit(FuncDeclaration *decl) LLVM_OVERRIDE {
     // don't touch function aliases, they don't contribute any new symbols
-    if (!decl->isFuncAliasDeclaration()) {
-      DtoDefineFunction(decl);
+    if (decl->isFuncAliasDeclaration()) {
+      return;
     }
+
+    if (irs->pruneUnreferenced && !decl->ir->isDefined() &&
+        isDeferrable(decl)) {
+      IF_LOG Logger::println("Deferring definition of %s until referenced",
+                             decl->toPrettyChars());
+      irs->deferredFunctions.push_back(decl);
+      return;
+    }
+
+    DtoDefineFunction(decl);
   }
 
   //////////////////////////////////////////////////////////////////////////
@@ -192,5 +192,6 @@ bool defineAsExternallyAvailable(FuncDeclaration &fdecl) {
   }
 
   IF_LOG Logger::println("defineAsExternallyAvailable? Yes.");
+  ++global.stats.inliningCandidates;
   return true;
 }
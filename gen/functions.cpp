@@ -829,6 +829,7 @@ void DtoDefineFunction(FuncDeclaration *fd, bool linkageAvailableExternally) {
     verifyScopedDestructionInClosure(fd);
 
   assert(fd->ident != Id::empty);
+  ++global.stats.functionsCodegenned;
 
   if (fd->semanticRun != PASSsemantic3done) {
     error(fd->loc, "Internal Compiler Error: function not fully analyzed; "
@@ -988,6 +989,8 @@ void DtoDefineFunction(FuncDeclaration *fd, bool linkageAvailableExternally) {
   // Initialize PGO state for this function
   irFunc->pgo.assignRegionCounters(fd, irFunc->func);
 
+  applyOptimizationStrategy(irFunc->func);
+
   {
     ScopeStack scopeStack(gIR);
     irFunc->scopes = &scopeStack;
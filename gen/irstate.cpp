@@ -40,6 +40,8 @@ IRState::IRState(const char *name, llvm::LLVMContext &context)
 
   dmodule = nullptr;
   mainFunc = nullptr;
+  pruneUnreferenced = false;
+  reduceModuleInfoImports = false;
   ir.state = this;
   asmBlock = nullptr;
 }
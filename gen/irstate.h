@@ -25,7 +25,9 @@
 #include <set>
 #include <sstream>
 #include <vector>
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/IR/Attributes.h"
 #include "llvm/ProfileData/InstrProfReader.h"
 #include "llvm/IR/CallSite.h"
 
@@ -52,6 +54,7 @@ class Module;
 class TypeStruct;
 struct BaseClass;
 class AnonDeclaration;
+class TemplateInstance;
 
 struct IrFunction;
 struct IrModule;
@@ -189,6 +192,41 @@ struct IRState {
   llvm::SmallVector<llvm::Value *, 5> LinkerMetadataArgs;
 #endif
 
+  // Functions defined by pragma(LDC_inline_ir) templates, keyed by the
+  // template instance and the function attributes inherited from the
+  // enclosing function. Parsing and linking in the IR is done only once per
+  // key; all further call sites in the module reuse the function.
+  llvm::DenseMap<std::pair<TemplateInstance *, llvm::AttributeSet>,
+                 llvm::Function *>
+      inlineIRFunctions;
+
+  // Cold stubs calling a noreturn runtime failure function (e.g.
+  // _d_arraybounds) with a constant file name or ModuleInfo argument, keyed by
+  // the runtime function and that argument. See DtoFailureCall().
+  llvm::DenseMap<std::pair<llvm::Function *, llvm::Constant *>,
+                 llvm::Function *>
+      failureStubs;
+
+  // Constant TypeInfo arrays for the _arguments parameter of D-style variadic
+  // calls, keyed by their initializer. Call sites with the same variadic
+  // argument types share one array.
+  llvm::DenseMap<llvm::Constant *, llvm::GlobalVariable *>
+      typeInfoArgumentsCache;
+
+  // Whether template functions and TypeInfos are only emitted once they are
+  // referenced from the generated code (-prune-unreferenced). This requires
+  // the IR module to contain the whole program.
+  bool pruneUnreferenced;
+
+  // Whether imports implied by other imports are omitted from the ModuleInfos
+  // (-reduce-moduleinfo-imports). This requires all root modules to end up in
+  // the same executable.
+  bool reduceModuleInfoImports;
+
+  // Template functions whose definition has been postponed until they are
+  // referenced, see defineReferencedFunctions() in gen/module.cpp.
+  std::vector<FuncDeclaration *> deferredFunctions;
+
 #if LDC_LLVM_VER >= 308
   // MS C++ compatible type descriptors
   llvm::DenseMap<size_t, llvm::StructType *> TypeDescriptorTypeMap;
@@ -245,26 +245,83 @@ LLValue *DtoAllocaDump(LLValue *val, LLType *asType, int alignment,
 void DtoAssert(Module *M, Loc &loc, DValue *msg) {
   // func
   const char *fname = msg ? "_d_assert_msg" : "_d_assert";
-  llvm::Function *fn = getRuntimeFunction(loc, gIR->module, fname);
 
   // Arguments
-  llvm::SmallVector<LLValue *, 3> args;
+  llvm::SmallVector<LLValue *, 2> args;
 
   // msg param
   if (msg) {
     args.push_back(DtoRVal(msg));
   }
 
-  // file param
-  args.push_back(DtoModuleFileName(M, loc));
-
   // line param
   args.push_back(DtoConstUint(loc.linnum));
 
-  // call
-  gIR->func()->scopes->callOrInvoke(fn, args);
+  // the file param is supplied by the stub
+  auto file = llvm::cast<LLConstant>(DtoModuleFileName(M, loc));
+  DtoFailureCall(loc, fname, file, msg ? 1 : 0, args);
+}
+
+/******************************************************************************
+ * FAILURE CALL STUBS
+ ******************************************************************************/
+
+static llvm::Function *getFailureStub(Loc &loc, const char *fname,
+                                      LLConstant *constArg,
+                                      unsigned constArgIndex) {
+  llvm::Function *fn = getRuntimeFunction(loc, gIR->module, fname);
+
+  llvm::Function *&stub = gIR->failureStubs[std::make_pair(fn, constArg)];
+  if (stub) {
+    return stub;
+  }
+
+  LLFunctionType *fnTy = fn->getFunctionType();
+  std::vector<LLType *> params;
+  for (unsigned i = 0; i < fnTy->getNumParams(); ++i) {
+    if (i != constArgIndex) {
+      params.push_back(fnTy->getParamType(i));
+    }
+  }
+
+  stub = LLFunction::Create(
+      LLFunctionType::get(fnTy->getReturnType(), params, false),
+      LLGlobalValue::InternalLinkage, std::string(".fail.") + fname,
+      &gIR->module);
+  stub->addFnAttr(LLAttribute::NoInline);
+  stub->addFnAttr(LLAttribute::Cold);
+  stub->addFnAttr(LLAttribute::NoReturn);
+  stub->addFnAttr(LLAttribute::OptimizeForSize);
+  // See functions.cpp:DtoDefineFunction()
+  if (global.params.targetTriple->getArch() == llvm::Triple::x86_64) {
+    stub->addFnAttr(LLAttribute::UWTable);
+  }
+
+  llvm::BasicBlock *bb = llvm::BasicBlock::Create(gIR->context(), "", stub);
+  IRBuilder<> builder(bb);
+
+  llvm::SmallVector<LLValue *, 3> args;
+  auto stubArg = stub->arg_begin();
+  for (unsigned i = 0; i < fnTy->getNumParams(); ++i) {
+    if (i == constArgIndex) {
+      args.push_back(constArg);
+    } else {
+      args.push_back(&*stubArg++);
+    }
+  }
+  llvm::CallInst *call = builder.CreateCall(fn, args);
+  call->setAttributes(fn->getAttributes());
+  builder.CreateUnreachable();
+
+  return stub;
+}
+
+void DtoFailureCall(Loc &loc, const char *fname, LLConstant *constArg,
+                    unsigned constArgIndex, llvm::ArrayRef<LLValue *> args) {
+  llvm::Function *stub = getFailureStub(loc, fname, constArg, constArgIndex);
+  gIR->func()->scopes->callOrInvoke(stub, args);
 
-  // after assert is always unreachable
+  // the function does not return
   gIR->ir->CreateUnreachable();
 }
 
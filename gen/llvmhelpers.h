@@ -66,6 +66,14 @@ LLValue *DtoAllocaDump(LLValue *val, LLType *asType, int alignment = 0,
 // assertion generator
 void DtoAssert(Module *M, Loc &loc, DValue *msg);
 
+/// Calls the noreturn runtime function `fname` reporting a failure at `loc`,
+/// e.g. _d_arraybounds. The call goes through an internal cold stub which
+/// supplies the constant argument `constArg` at `constArgIndex` (the file
+/// name or ModuleInfo), so that each call site only passes the remaining
+/// `args` (the line and message). Terminates the current basic block.
+void DtoFailureCall(Loc &loc, const char *fname, LLConstant *constArg,
+                    unsigned constArgIndex, llvm::ArrayRef<LLValue *> args);
+
 // returns module file name
 LLValue *DtoModuleFileName(Module *M, const Loc &loc);
 
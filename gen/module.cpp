@@ -41,6 +41,8 @@
 #include "ir/irmodule.h"
 #include "ir/irtype.h"
 #include "ir/irvar.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
@@ -762,6 +764,29 @@ static void loadInstrProfileData(IRState *irs) {
 
 static void genModuleInfo(Module *m, bool emitFullModuleInfo);
 
+/// Defines the deferred template functions (-prune-unreferenced) which are
+/// referenced by now. Defining a function may reference further ones, so this
+/// iterates until nothing changes; the remaining ones may still be referenced
+/// by the next module of a -singleobj compilation.
+static void defineReferencedFunctions(IRState *irs) {
+  for (bool changed = true; changed;) {
+    changed = false;
+    std::vector<FuncDeclaration *> pending;
+    pending.swap(irs->deferredFunctions);
+    for (auto fd : pending) {
+      if (fd->ir->isDefined()) {
+        continue;
+      }
+      if (fd->ir->isDeclared() && !getIrFunc(fd)->func->use_empty()) {
+        DtoDefineFunction(fd);
+        changed = true;
+      } else {
+        irs->deferredFunctions.push_back(fd);
+      }
+    }
+  }
+}
+
 void codegenModule(IRState *irs, Module *m, bool emitFullModuleInfo) {
   assert(!irs->dmodule &&
          "irs->module not null, codegen already in progress?!");
@@ -786,9 +811,17 @@ void codegenModule(IRState *irs, Module *m, bool emitFullModuleInfo) {
   for (unsigned k = 0; k < m->members->dim; k++) {
     Dsymbol *dsym = (*m->members)[k];
     assert(dsym);
+    // TypeInfos requested during semantic analysis are emitted on first use.
+    if (irs->pruneUnreferenced && dsym->isTypeInfoDeclaration()) {
+      continue;
+    }
     Declaration_codegen(dsym);
   }
 
+  if (irs->pruneUnreferenced) {
+    defineReferencedFunctions(irs);
+  }
+
   if (global.errors) {
     fatal();
   }
@@ -810,6 +843,122 @@ void codegenModule(IRState *irs, Module *m, bool emitFullModuleInfo) {
   irs->dmodule = nullptr;
 }
 
+namespace {
+/// Appends the imports of m which need a ModuleInfo, i.e. the edges of the
+/// module constructor dependency graph druntime sorts at startup.
+void getModuleInfoImports(Module *m, llvm::SmallVectorImpl<Module *> &result) {
+  for (size_t i = 0; i < m->aimports.dim; i++) {
+    Module *mod = static_cast<Module *>(m->aimports.data[i]);
+    if (mod->needModuleInfo() && mod != m) {
+      result.push_back(mod);
+    }
+  }
+}
+
+/// Tarjan's algorithm over the ModuleInfo import graph, recording for each
+/// module whether it is part of an import cycle.
+class ImportCycleFinder {
+  struct Node {
+    unsigned index;
+    unsigned lowlink;
+    bool onStack;
+  };
+  llvm::DenseMap<Module *, Node> nodes;
+  std::vector<Module *> stack;
+  unsigned nextIndex = 0;
+
+public:
+  llvm::DenseMap<Module *, bool> inCycle;
+
+  void visit(Module *m) {
+    nodes[m] = {nextIndex, nextIndex, true};
+    ++nextIndex;
+    stack.push_back(m);
+
+    llvm::SmallVector<Module *, 16> imports;
+    getModuleInfoImports(m, imports);
+    for (Module *imp : imports) {
+      auto it = nodes.find(imp);
+      if (it == nodes.end()) {
+        visit(imp);
+        nodes[m].lowlink = std::min(nodes[m].lowlink, nodes[imp].lowlink);
+      } else if (it->second.onStack) {
+        nodes[m].lowlink = std::min(nodes[m].lowlink, it->second.index);
+      }
+    }
+
+    if (nodes[m].lowlink == nodes[m].index) {
+      Module *top;
+      bool cyclic = stack.back() != m;
+      do {
+        top = stack.back();
+        stack.pop_back();
+        nodes[top].onStack = false;
+        inCycle[top] = cyclic;
+      } while (top != m);
+    }
+  }
+};
+
+/// Returns whether the importedModules of m are emitted by this compiler
+/// invocation and m is not part of an import cycle. Reachability through
+/// such modules is preserved when their own redundant imports are omitted,
+/// so it can be used to omit imports implied by other ones.
+bool isReducibleImport(Module *m) {
+  static ImportCycleFinder finder;
+  if (!m->isRoot()) {
+    return false;
+  }
+  auto it = finder.inCycle.find(m);
+  if (it == finder.inCycle.end()) {
+    finder.visit(m);
+    it = finder.inCycle.find(m);
+  }
+  return !it->second;
+}
+
+/// Returns the imports to list in the ModuleInfo of m. Druntime only needs
+/// them to order the module constructors, so an import which is also
+/// reachable through another listed import (as in A imports B and C, B
+/// imports C) can be omitted, shrinking the graph sorted at every program
+/// start. This is only done with -reduce-moduleinfo-imports.
+void getReducedModuleInfoImports(Module *m,
+                                 llvm::SmallVectorImpl<Module *> &result) {
+  llvm::SmallVector<Module *, 16> imports;
+  getModuleInfoImports(m, imports);
+  if (!gIR->reduceModuleInfoImports) {
+    result.append(imports.begin(), imports.end());
+    return;
+  }
+
+  llvm::SmallPtrSet<Module *, 32> reached;
+  for (Module *imp : imports) {
+    if (reached.count(imp)) {
+      IF_LOG Logger::println("omitting import %s implied by other imports",
+                             imp->toPrettyChars());
+      continue;
+    }
+    result.push_back(imp);
+
+    llvm::SmallVector<Module *, 16> worklist;
+    worklist.push_back(imp);
+    while (!worklist.empty()) {
+      Module *cur = worklist.pop_back_val();
+      if (!isReducibleImport(cur)) {
+        continue;
+      }
+      llvm::SmallVector<Module *, 16> next;
+      getModuleInfoImports(cur, next);
+      for (Module *n : next) {
+        if (reached.insert(n).second) {
+          worklist.push_back(n);
+        }
+      }
+    }
+  }
+}
+} // anonymous namespace
+
 // Put out instance of ModuleInfo for this Module
 static void genModuleInfo(Module *m, bool emitFullModuleInfo) {
   // resolve ModuleInfo
@@ -838,12 +987,9 @@ static void genModuleInfo(Module *m, bool emitFullModuleInfo) {
   std::vector<LLConstant *> importInits;
   LLConstant *importedModules = nullptr;
   llvm::ArrayType *importedModulesTy = nullptr;
-  for (size_t i = 0; i < m->aimports.dim; i++) {
-    Module *mod = static_cast<Module *>(m->aimports.data[i]);
-    if (!mod->needModuleInfo() || mod == m) {
-      continue;
-    }
-
+  llvm::SmallVector<Module *, 16> imports;
+  getReducedModuleInfoImports(m, imports);
+  for (Module *mod : imports) {
     importInits.push_back(
         DtoBitCast(getIrModule(mod)->moduleInfoSymbol(), moduleInfoPtrTy));
   }
@@ -25,6 +25,13 @@ static unsigned getVthisIdx(AggregateDeclaration *ad) {
 
 static void DtoCreateNestedContextType(FuncDeclaration *fd);
 
+/// Returns the prologue-loaded frame of the given depth, or null if the
+/// current function has not cached it.
+static LLValue *getOuterFrame(IrFunction *irfunc, unsigned depth) {
+  return depth < irfunc->outerFrames.size() ? irfunc->outerFrames[depth]
+                                            : nullptr;
+}
+
 DValue *DtoNestedVariable(Loc &loc, Type *astype, VarDeclaration *vd,
                           bool byref) {
   IF_LOG Logger::println("DtoNestedVariable for %s @ %s", vd->toChars(),
@@ -125,10 +132,14 @@ DValue *DtoNestedVariable(Loc &loc, Type *astype, VarDeclaration *vd,
       gIR->DBuilder.OpDeref(dwarfAddr);
     }
     IF_LOG Logger::println("Lower depth");
-    val = DtoGEPi(val, 0, vardepth);
-    IF_LOG Logger::cout() << "Frame index: " << *val << '\n';
-    val = DtoAlignedLoad(
-        val, (std::string(".frame.") + vdparent->toChars()).c_str());
+    if (LLValue *frame = getOuterFrame(irfunc, vardepth)) {
+      val = frame;
+    } else {
+      val = DtoGEPi(val, 0, vardepth);
+      IF_LOG Logger::cout() << "Frame index: " << *val << '\n';
+      val = DtoAlignedLoad(
+          val, (std::string(".frame.") + vdparent->toChars()).c_str());
+    }
     IF_LOG Logger::cout() << "Frame: " << *val << '\n';
   }
 
@@ -285,6 +296,8 @@ LLValue *DtoNestedContext(Loc &loc, Dsymbol *sym) {
       // fd needs the same context as we do, so all is well
       IF_LOG Logger::println(
           "Calling sibling function or directly nested function");
+    } else if (LLValue *frame = getOuterFrame(irfunc, neededDepth)) {
+      val = frame;
     } else {
       val = DtoBitCast(val,
                        LLPointerType::getUnqual(getIrFunc(ctxfd)->frameType));
@@ -408,6 +421,17 @@ static void DtoCreateNestedContextType(FuncDeclaration *fd) {
   irFunc.frameTypeAlignment = builder.overallAlignment();
 }
 
+/// Loads the pointers to all enclosing frames from the frame list at the
+/// start of the given context, so that accesses to variables of outer
+/// functions only need to load the variable itself. The frame list is never
+/// modified after the prologue; unused loads are removed by the optimizer.
+static void cacheOuterFrames(IrFunction *irfunc, LLValue *context) {
+  for (int i = 0; i < irfunc->depth; ++i) {
+    irfunc->outerFrames.push_back(
+        DtoAlignedLoad(DtoGEPi(context, 0, i), ".frame"));
+  }
+}
+
 void DtoCreateNestedContext(FuncDeclaration *fd) {
   IF_LOG Logger::println("DtoCreateNestedContext for %s", fd->toPrettyChars());
   LOG_SCOPE
@@ -461,6 +485,8 @@ void DtoCreateNestedContext(FuncDeclaration *fd) {
       src = DtoBitCast(src, frameType->getContainedType(depth - 1));
       LLValue *gep = DtoGEPi(frame, 0, depth - 1);
       DtoAlignedStore(src, gep);
+
+      cacheOuterFrames(irfunction, frame);
     }
 
     // store context in IrFunction
@@ -513,5 +539,16 @@ void DtoCreateNestedContext(FuncDeclaration *fd) {
         gIR->DBuilder.EmitLocalVariable(gep, vd, nullptr, false, false, addr);
       }
     }
+  } else {
+    // The context of the parent is passed on unmodified; its frame is the
+    // innermost one.
+    IrFunction *irfunction = getIrFunc(fd);
+    if (irfunction->nestArg && irfunction->frameType) {
+      LLValue *ctx =
+          DtoBitCast(DtoLoad(irfunction->nestArg),
+                     LLPointerType::getUnqual(irfunction->frameType));
+      cacheOuterFrames(irfunction, ctx);
+      irfunction->outerFrames.push_back(ctx);
+    }
   }
 }
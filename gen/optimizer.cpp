@@ -31,7 +31,9 @@
 #include "llvm/Target/TargetLibraryInfo.h"
 #endif
 #include "llvm/Target/TargetMachine.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/IR/LegacyPassNameParser.h"
 #include "llvm/Transforms/Instrumentation.h"
 #include "llvm/Transforms/IPO.h"
@@ -126,6 +128,19 @@ static cl::opt<bool>
                             cl::desc("Disable the slp vectorization pass"),
                             cl::init(false));
 
+static cl::opt<std::string> hotFunctionsFile(
+    "hot-functions", cl::value_desc("file"),
+    cl::desc("Optimize only the functions listed in <file> (one mangled name "
+             "per line) for speed and all other functions for size"));
+
+#if LDC_LLVM_VER >= 307
+static cl::opt<bool> pgoColdOptSize(
+    "pgo-cold-optsize",
+    cl::desc("Optimize functions never executed according to the "
+             "-fprofile-instr-use data for size"),
+    cl::ZeroOrMore);
+#endif
+
 static unsigned optLevel() {
   // Use -O2 as a base for the size-optimization levels.
   return optimizeLevel >= 0 ? optimizeLevel : 2;
@@ -165,6 +180,62 @@ llvm::CodeGenOpt::Level codeGenOptLevel() {
   return llvm::CodeGenOpt::Default;
 }
 
+/// Returns the set of function names read from the -hot-functions file.
+static const llvm::StringSet<> &getHotFunctions() {
+  static llvm::StringSet<> hotFunctions;
+  static bool loaded = false;
+  if (loaded) {
+    return hotFunctions;
+  }
+  loaded = true;
+
+  auto buffer = llvm::MemoryBuffer::getFile(hotFunctionsFile);
+  if (!buffer) {
+    error(Loc(), "cannot read hot functions file '%s': %s",
+          hotFunctionsFile.c_str(), buffer.getError().message().c_str());
+    fatal();
+  }
+
+  llvm::SmallVector<llvm::StringRef, 0> lines;
+  (*buffer)->getBuffer().split(lines, '\n');
+  for (llvm::StringRef line : lines) {
+    line = line.trim();
+    if (!line.empty() && line[0] != '#') {
+      hotFunctions.insert(line);
+    }
+  }
+  return hotFunctions;
+}
+
+void applyOptimizationStrategy(llvm::Function *func) {
+  if (optLevel() == 0 || sizeLevel() > 0 ||
+      func->hasFnAttribute(llvm::Attribute::OptimizeNone) ||
+      func->hasFnAttribute(llvm::Attribute::OptimizeForSize)) {
+    return;
+  }
+
+  bool optimizeForSize = false;
+  if (!hotFunctionsFile.empty()) {
+    llvm::StringRef name = func->getName();
+    // Strip the "do not mangle" prefix of symbols with explicit names.
+    if (name.startswith("\1")) {
+      name = name.drop_front();
+    }
+    optimizeForSize = !getHotFunctions().count(name);
+  }
+#if LDC_LLVM_VER >= 307
+  else if (pgoColdOptSize) {
+    auto entryCount = func->getEntryCount();
+    optimizeForSize = entryCount.hasValue() && entryCount.getValue() == 0;
+  }
+#endif
+
+  if (optimizeForSize) {
+    IF_LOG Logger::println("Optimizing %s for size", func->getName().data());
+    func->addFnAttr(llvm::Attribute::OptimizeForSize);
+  }
+}
+
 static inline void addPass(PassManagerBase &pm, Pass *pass) {
   pm.add(pass);
 
@@ -33,11 +33,18 @@ extern llvm::cl::opt<SanitizerCheck> sanitize;
 }
 
 namespace llvm {
+class Function;
 class Module;
 }
 
 bool ldc_optimize_module(llvm::Module *m);
 
+/// Adds an optsize attribute to func if it is not hot according to the
+/// -hot-functions list or the profile data (-pgo-cold-optsize), so that only
+/// the hot functions get the full optimization level's unrolling,
+/// vectorization and inlining.
+void applyOptimizationStrategy(llvm::Function *func);
+
 // Returns whether the normal, full inlining pass will be run.
 bool willInline();
 
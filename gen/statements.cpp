@@ -1952,17 +1952,19 @@ public:
     auto &PGO = irs->func()->pgo;
     PGO.setCurrentStmt(stmt);
 
-    llvm::Function *fn =
-        getRuntimeFunction(stmt->loc, irs->module, "_d_switch_error");
-
-    LLValue *moduleInfoSymbol =
+    LLConstant *moduleInfoSymbol =
         getIrModule(irs->func()->decl->getModule())->moduleInfoSymbol();
     LLType *moduleInfoType = DtoType(Module::moduleinfo->type);
 
-    LLCallSite call = irs->CreateCallOrInvoke(
-        fn, DtoBitCast(moduleInfoSymbol, getPtrToType(moduleInfoType)),
-        DtoConstUint(stmt->loc.linnum));
-    call.setDoesNotReturn();
+    LLValue *line = DtoConstUint(stmt->loc.linnum);
+    DtoFailureCall(
+        stmt->loc, "_d_switch_error",
+        DtoBitCast(moduleInfoSymbol, getPtrToType(moduleInfoType)), 0, line);
+
+    // TODO: Should not be needed.
+    llvm::BasicBlock *bb = llvm::BasicBlock::Create(
+        irs->context(), "afterswitcherror", irs->topfunc());
+    irs->scope() = IRScope(bb);
   }
 
   //////////////////////////////////////////////////////////////////////////
@@ -70,9 +70,48 @@ void DtoResolveStruct(StructDeclaration *sd, Loc &callerLoc) {
 ///////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+/// The maximum number of fields compared one by one instead of by memcmp.
+const size_t maxFieldwiseCompareFields = 8;
+
+/// Returns whether the fields of sd cover the whole struct without padding or
+/// overlap (unions), i.e. its values can be compared as one block of memory.
+bool hasNoHoles(StructDeclaration *sd) {
+  d_uns64 offset = 0;
+  for (auto vd : sd->fields) {
+    if (vd->offset != offset) {
+      return false;
+    }
+    offset += vd->type->size();
+  }
+  return offset == sd->structsize;
+}
+
+/// Returns whether the struct can be compared field by field with integer
+/// comparisons: all fields are integers or pointers and don't overlap.
+bool isFieldwiseComparable(StructDeclaration *sd) {
+  if (sd->fields.dim > maxFieldwiseCompareFields) {
+    return false;
+  }
+  d_uns64 offset = 0;
+  for (auto vd : sd->fields) {
+    Type *ft = vd->type->toBasetype();
+    if (!ft->isintegral() && ft->ty != Tpointer) {
+      return false;
+    }
+    if (vd->offset < offset) {
+      return false;
+    }
+    offset = vd->offset + ft->size();
+  }
+  return true;
+}
+}
+
 LLValue *DtoStructEquals(TOK op, DValue *lhs, DValue *rhs) {
   Type *t = lhs->type->toBasetype();
   assert(t->ty == Tstruct);
+  StructDeclaration *sd = static_cast<TypeStruct *>(t)->sym;
 
   // set predicate
   llvm::ICmpInst::Predicate cmpop;
@@ -83,10 +122,42 @@ LLValue *DtoStructEquals(TOK op, DValue *lhs, DValue *rhs) {
   }
 
   // empty struct? EQ always true, NE always false
-  if (static_cast<TypeStruct *>(t)->sym->fields.dim == 0) {
+  if (sd->fields.dim == 0) {
     return DtoConstBool(cmpop == llvm::ICmpInst::ICMP_EQ);
   }
 
+  // Small structs without padding: compare as a single integer.
+  const d_uns64 structSize = sd->structsize;
+  if ((structSize == 1 || structSize == 2 || structSize == 4 ||
+       structSize == 8 || structSize == 16) &&
+      hasNoHoles(sd)) {
+    LLType *intTy = LLIntegerType::get(gIR->context(), structSize * 8);
+    LLValue *lv = DtoLoad(DtoBitCast(DtoLVal(lhs), getPtrToType(intTy)));
+    LLValue *rv = DtoLoad(DtoBitCast(DtoLVal(rhs), getPtrToType(intTy)));
+    // The struct might be less aligned than the integer.
+    llvm::cast<llvm::LoadInst>(lv)->setAlignment(DtoAlignment(t));
+    llvm::cast<llvm::LoadInst>(rv)->setAlignment(DtoAlignment(t));
+    return gIR->ir->CreateICmp(cmpop, lv, rv);
+  }
+
+  // Integer and pointer fields: compare them one by one, which skips the
+  // padding between them and lets LLVM keep the operands in registers.
+  if (isFieldwiseComparable(sd)) {
+    LLValue *lptr = DtoLVal(lhs);
+    LLValue *rptr = DtoLVal(rhs);
+    LLValue *result = nullptr;
+    for (auto vd : sd->fields) {
+      LLValue *lv = DtoLoad(DtoIndexAggregate(lptr, sd, vd));
+      LLValue *rv = DtoLoad(DtoIndexAggregate(rptr, sd, vd));
+      LLValue *eq = gIR->ir->CreateICmp(llvm::ICmpInst::ICMP_EQ, lv, rv);
+      result = result ? gIR->ir->CreateAnd(result, eq) : eq;
+    }
+    if (cmpop == llvm::ICmpInst::ICMP_NE) {
+      result = gIR->ir->CreateNot(result);
+    }
+    return result;
+  }
+
   // call memcmp
   size_t sz = getTypeAllocSize(DtoType(t));
   LLValue *val = DtoMemCmp(DtoLVal(lhs), DtoLVal(rhs), DtoConstSize_t(sz));
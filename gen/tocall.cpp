@@ -225,33 +225,35 @@ static LLValue *getTypeinfoArrayArgumentForDVarArg(Expressions *arguments,
   LLArrayType *typeinfoarraytype =
       LLArrayType::get(typeinfotype, numVariadicArgs);
 
-  auto typeinfomem = new llvm::GlobalVariable(
-      gIR->module, typeinfoarraytype, true, llvm::GlobalValue::InternalLinkage,
-      nullptr, "._arguments.storage");
-  IF_LOG Logger::cout() << "_arguments storage: " << *typeinfomem << '\n';
-
   std::vector<LLConstant *> vtypeinfos;
   vtypeinfos.reserve(n_arguments);
   for (size_t i = begin; i < n_arguments; i++) {
     vtypeinfos.push_back(DtoTypeInfoOf((*arguments)[i]->type));
   }
-
-  // apply initializer
   LLConstant *tiinits = LLConstantArray::get(typeinfoarraytype, vtypeinfos);
-  typeinfomem->setInitializer(tiinits);
 
-  // put data in d-array
+  // All call sites passing the same argument types share the storage.
+  llvm::GlobalVariable *&typeinfomem = gIR->typeInfoArgumentsCache[tiinits];
+  if (!typeinfomem) {
+    typeinfomem = new llvm::GlobalVariable(
+        gIR->module, typeinfoarraytype, true,
+        llvm::GlobalValue::InternalLinkage, tiinits, "._arguments.storage");
+#if LDC_LLVM_VER >= 309
+    typeinfomem->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+#else
+    typeinfomem->setUnnamedAddr(true);
+#endif
+    IF_LOG Logger::cout() << "_arguments storage: " << *typeinfomem << '\n';
+  }
+
+  // The slice itself is a constant; pass it by value without going through
+  // memory.
   LLConstant *pinits[] = {
       DtoConstSize_t(numVariadicArgs),
       llvm::ConstantExpr::getBitCast(typeinfomem, getPtrToType(typeinfotype))};
   LLType *tiarrty = DtoType(Type::dtypeinfo->type->arrayOf());
-  tiinits = LLConstantStruct::get(isaStruct(tiarrty),
-                                  llvm::ArrayRef<LLConstant *>(pinits));
-  LLValue *typeinfoarrayparam = new llvm::GlobalVariable(
-      gIR->module, tiarrty, true, llvm::GlobalValue::InternalLinkage, tiinits,
-      "._arguments.array");
-
-  return DtoLoad(typeinfoarrayparam);
+  return LLConstantStruct::get(isaStruct(tiarrty),
+                               llvm::ArrayRef<LLConstant *>(pinits));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
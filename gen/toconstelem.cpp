@@ -615,9 +615,16 @@ public:
       IF_LOG Logger::cout() << "Using existing global: " << *value->globalVar
                             << '\n';
     } else {
+      // Immutable instances can be placed in read-only memory, unless they
+      // have a monitor field which is lazily set by synchronized statements
+      // (i.e. all but C++ classes).
+      const bool isConstant =
+          e->type->isImmutable() && origClass->isCPPclass();
+
       value->globalVar = new llvm::GlobalVariable(
           p->module, origClass->type->ctype->isClass()->getMemoryLLType(),
-          false, llvm::GlobalValue::InternalLinkage, nullptr, ".classref");
+          isConstant, llvm::GlobalValue::InternalLinkage, nullptr,
+          ".classref");
 
       std::map<VarDeclaration *, llvm::Constant *> varInits;
 
@@ -656,7 +663,7 @@ public:
       if (constValue->getType() !=
           value->globalVar->getType()->getContainedType(0)) {
         auto finalGlobalVar = new llvm::GlobalVariable(
-            p->module, constValue->getType(), false,
+            p->module, constValue->getType(), isConstant,
             llvm::GlobalValue::InternalLinkage, nullptr, ".classref");
         value->globalVar->replaceAllUsesWith(
             DtoBitCast(finalGlobalVar, value->globalVar->getType()));
@@ -2468,9 +2468,62 @@ public:
       slice = DtoConstSlice(DtoConstSize_t(e->keys->dim), slice);
       LLValue *valuesArray = DtoAggrPaint(slice, funcTy->getParamType(2));
 
-      LLValue *aa = gIR->CreateCallOrInvoke(func, aaTypeInfo, keysArray,
-                                            valuesArray, "aa")
-                        .getInstruction();
+      LLValue *aa;
+      if (e->type->isImmutable()) {
+        // An immutable literal can never be modified, so build the AA only
+        // once and cache it in a hidden global (which the GC scans like any
+        // other __gshared variable). Racing threads may both build it, which
+        // is harmless.
+        LLType *aaType = func->getReturnType();
+        auto cache = new LLGlobalVariable(
+            gIR->module, aaType, false, LLGlobalValue::InternalLinkage,
+            LLConstant::getNullValue(aaType), ".aaLiteralCache");
+        const unsigned alignment = getTypeAllocSize(aaType);
+
+        llvm::LoadInst *cached = p->ir->CreateLoad(cache, "aa.cached");
+        cached->setAtomic(
+#if LDC_LLVM_VER >= 309
+            llvm::AtomicOrdering::Acquire
+#else
+            llvm::Acquire
+#endif
+            );
+        cached->setAlignment(alignment);
+
+        llvm::BasicBlock *cachedbb = p->scopebb();
+        llvm::BasicBlock *buildbb =
+            llvm::BasicBlock::Create(p->context(), "aaliteral.build",
+                                     p->topfunc());
+        llvm::BasicBlock *endbb = llvm::BasicBlock::Create(
+            p->context(), "aaliteral.end", p->topfunc());
+        p->ir->CreateCondBr(p->ir->CreateIsNull(cached), buildbb, endbb);
+
+        p->scope() = IRScope(buildbb);
+        LLValue *built = gIR->CreateCallOrInvoke(func, aaTypeInfo, keysArray,
+                                                 valuesArray, "aa.built")
+                             .getInstruction();
+        llvm::StoreInst *store = p->ir->CreateStore(built, cache);
+        store->setAtomic(
+#if LDC_LLVM_VER >= 309
+            llvm::AtomicOrdering::Release
+#else
+            llvm::Release
+#endif
+            );
+        store->setAlignment(alignment);
+        buildbb = p->scopebb();
+        p->ir->CreateBr(endbb);
+
+        p->scope() = IRScope(endbb);
+        llvm::PHINode *phi = p->ir->CreatePHI(aaType, 2, "aa");
+        phi->addIncoming(cached, cachedbb);
+        phi->addIncoming(built, buildbb);
+        aa = phi;
+      } else {
+        aa = gIR->CreateCallOrInvoke(func, aaTypeInfo, keysArray, valuesArray,
+                                     "aa")
+                 .getInstruction();
+      }
       if (basetype->ty != Taarray) {
         LLValue *tmp = DtoAlloca(e->type, "aaliteral");
         DtoStore(aa, DtoGEPi(tmp, 0, 0));
@@ -732,6 +732,7 @@ void TypeInfoDeclaration_codegen(TypeInfoDeclaration *decl, IRState *p) {
   // define custom typedef
   LLVMDefineVisitor v;
   decl->accept(&v);
+  ++global.stats.typeInfosEmitted;
 }
 
 /* ========================================================================= */
@@ -497,6 +497,10 @@ struct IrFunction {
   // enclosing functions)
   int depth = -1;
   bool nestedContextCreated = false; // holds whether nested context is created
+  /// The frames of the enclosing functions, indexed by depth, loaded from the
+  /// context once in the function prologue. Empty if the context is reached
+  /// through the 'this' pointer of a nested aggregate.
+  std::vector<llvm::Value *> outerFrames;
 
   llvm::Value *_arguments = nullptr;
   llvm::Value *_argptr = nullptr;
@@ -0,0 +1,115 @@
+#!/usr/bin/env python
+"""Generated-code performance benchmark suite.
+
+Compiles the microbenchmarks in this directory with the given compiler and
+runs them pinned to a single CPU. Each benchmark binary prints one JSON
+object per measured operation (median ns/op and median absolute deviation,
+see inputs/harness.d); the results of all binaries are collected into one
+JSON file.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+SOURCE_DIR = os.path.dirname(os.path.abspath(__file__))
+
+# (source file, variant name, extra compiler flags)
+BENCHMARKS = [
+    ('aa.d', '', []),
+    ('arrays.d', '', []),
+    ('classes.d', '', []),
+    ('string_switch.d', '', []),
+    ('closures.d', '', []),
+    ('boundscheck.d', 'checked', ['-boundscheck=on']),
+    ('boundscheck.d', 'unchecked', ['-boundscheck=off']),
+    ('arrayops.d', '', []),
+    ('gc2stack.d', '', []),
+]
+
+COMMON_FLAGS = ['-O3', '-release']
+
+
+def pin_to_cpu(cpu):
+    """Returns a preexec_fn pinning the benchmark process to `cpu`."""
+    if cpu < 0 or not hasattr(os, 'sched_setaffinity'):
+        return None
+    return lambda: os.sched_setaffinity(0, [cpu])
+
+
+def build(ldc, source, variant, flags, workdir):
+    exe = os.path.join(workdir, os.path.splitext(source)[0] +
+                       ('-' + variant if variant else ''))
+    args = [ldc] + COMMON_FLAGS + flags + [
+        '-I' + os.path.join(SOURCE_DIR, 'inputs'),
+        '-od' + workdir,
+        '-of' + exe,
+        os.path.join(SOURCE_DIR, 'inputs', 'harness.d'),
+        os.path.join(SOURCE_DIR, source),
+    ]
+    subprocess.check_call(args)
+    return exe
+
+
+def run(exe, variant, repetitions, cpu):
+    output = subprocess.check_output(
+        [exe, '--repetitions=%d' % repetitions],
+        preexec_fn=pin_to_cpu(cpu), universal_newlines=True)
+    results = []
+    for line in output.splitlines():
+        line = line.strip()
+        if not line.startswith('{'):
+            continue
+        result = json.loads(line)
+        if variant:
+            result['benchmark'] += '.' + variant
+        results.append(result)
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--ldc', required=True, help='path to the ldc2 binary')
+    parser.add_argument('--output', help='write the results to this JSON file')
+    parser.add_argument('--repetitions', type=int, default=15,
+                        help='measured repetitions per benchmark (default: 15)')
+    parser.add_argument('--cpu', type=int, default=0,
+                        help='CPU to pin the benchmarks to, -1 to disable '
+                             '(default: 0)')
+    parser.add_argument('--filter', default='',
+                        help='only run benchmark files containing this string')
+    args = parser.parse_args()
+
+    workdir = tempfile.mkdtemp(prefix='ldc-codegen-bench-')
+    results = []
+    try:
+        for source, variant, flags in BENCHMARKS:
+            if args.filter not in source:
+                continue
+            exe = build(args.ldc, source, variant, flags, workdir)
+            results += run(exe, variant, args.repetitions, args.cpu)
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+    fmt = '%-40s %12s %10s'
+    print(fmt % ('benchmark', 'ns/op', 'MAD'))
+    for r in results:
+        print(fmt % (r['benchmark'], '%.3f' % r['ns_per_op'], '%.3f' % r['mad']))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump({'compiler': args.ldc, 'flags': COMMON_FLAGS,
+                       'results': results}, f, indent=2, sort_keys=True)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
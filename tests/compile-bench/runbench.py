@@ -0,0 +1,352 @@
+#!/usr/bin/env python
+"""Compiler performance benchmark suite.
+
+Generates synthetic D workloads that stress specific parts of the compiler,
+compiles each of them a number of times and records the wall time, the peak
+memory usage (max RSS) and the per-phase times of the compiler.
+The results are written as JSON and compared against a stored baseline; the
+script exits with a non-zero status if any metric regressed by more than the
+given threshold.
+
+The wall time is measured for plain compilations. The per-phase times and
+the peak memory usage are reported by the compiler itself in its -stats-file,
+written by one additional compilation per benchmark.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+#
+# Workload generators. Each one writes its sources into the given directory
+# and returns the list of files to pass to the compiler.
+#
+
+def gen_template_recursion(dir):
+    src = '''
+struct List(int n)
+{
+    static if (n > 0)
+    {
+        List!(n - 1) tail;
+        enum length = List!(n - 1).length + 1;
+    }
+    else
+        enum length = 0;
+}
+
+template Fib(int n)
+{
+    static if (n < 2)
+        enum Fib = n;
+    else
+        enum Fib = (Fib!(n - 1) + Fib!(n - 2)) % 1000003;
+}
+
+static assert(List!400.length == 400);
+static assert(Fib!400 >= 0);
+'''
+    return [write_file(dir, 'template_recursion.d', src)]
+
+
+def gen_ctfe(dir):
+    src = '''
+bool[] sieve(size_t n)
+{
+    auto composite = new bool[n];
+    foreach (i; 2 .. n)
+        if (!composite[i])
+            for (size_t j = i * i; j < n; j += i)
+                composite[j] = true;
+    return composite;
+}
+
+string buildTable(size_t n)
+{
+    string s;
+    foreach (i, c; sieve(n))
+        if (!c && i > 1)
+            s ~= cast(char)('0' + i % 10);
+    return s;
+}
+
+enum table = buildTable(200_000);
+static assert(table.length > 0);
+'''
+    return [write_file(dir, 'ctfe.d', src)]
+
+
+def gen_string_mixin(dir):
+    src = '''
+string genFunctions(int n)
+{
+    string s;
+    foreach (i; 0 .. n)
+    {
+        auto num = cast(char)('0' + i % 10) ~ "";
+        string id;
+        for (int k = i; ; k /= 10)
+        {
+            id = cast(char)('0' + k % 10) ~ id;
+            if (k < 10)
+                break;
+        }
+        s ~= "int fun" ~ id ~ "(int x) { return x * " ~ num ~ " + " ~ id ~
+             "; }\\n";
+    }
+    return s;
+}
+
+mixin(genFunctions(5000));
+'''
+    return [write_file(dir, 'string_mixin.d', src)]
+
+
+def gen_import_graph(dir, numModules=1000):
+    files = []
+    for i in range(numModules):
+        imports = ''.join('import mod%d;\n' % j
+                          for j in (i - 1, i // 2, i // 3) if 0 <= j < i)
+        src = imports + '''
+struct S%(i)d { int a; long b; string c; }
+int fun%(i)d(int x) { return x + %(i)d; }
+class C%(i)d { int value() { return fun%(i)d(%(i)d); } }
+''' % {'i': i}
+        files.append(write_file(dir, 'mod%d.d' % i, src))
+    return files
+
+
+def gen_switch_array_literals(dir, numCases=5000, numElements=50000):
+    cases = ''.join('    case %d: return %d;\n' % (i, i * 7 % 13)
+                    for i in range(numCases))
+    elements = ', '.join(str(i * 31 % 257) for i in range(numElements))
+    src = '''
+int bigSwitch(int x)
+{
+    switch (x)
+    {
+%s
+    default: return -1;
+    }
+}
+
+immutable int[] bigArray = [%s];
+''' % (cases, elements)
+    return [write_file(dir, 'switch_array_literals.d', src)]
+
+
+def gen_optimization(dir):
+    src = '''
+struct Matrix
+{
+    double[] data;
+    size_t n;
+
+    this(size_t n) { this.n = n; data = new double[n * n]; data[] = 1; }
+    ref double opIndex(size_t i, size_t j) { return data[i * n + j]; }
+
+    Matrix opBinary(string op : "*")(ref Matrix b)
+    {
+        auto c = Matrix(n);
+        foreach (i; 0 .. n)
+            foreach (j; 0 .. n)
+            {
+                double s = 0;
+                foreach (k; 0 .. n)
+                    s += this[i, k] * b[k, j];
+                c[i, j] = s;
+            }
+        return c;
+    }
+}
+
+T reduce(alias f, T)(T[] a, T init)
+{
+    foreach (x; a)
+        init = f(init, x);
+    return init;
+}
+
+double work(size_t n)
+{
+    auto a = Matrix(n);
+    auto b = a * a;
+    return reduce!((x, y) => x + y)(b.data, 0.0);
+}
+'''
+    # Instantiate enough code for the optimizer to have something to do.
+    src += ''.join('double work%d() { return work(%d) + reduce!((x, y) => x * y + %d)([1.0, 2.0], 1.0); }\n'
+                   % (i, i + 1, i) for i in range(300))
+    return [write_file(dir, 'optimization.d', src)]
+
+
+BENCHMARKS = [
+    # (name, generator, extra flags)
+    ('template-recursion', gen_template_recursion, []),
+    ('ctfe', gen_ctfe, []),
+    ('string-mixin', gen_string_mixin, []),
+    ('import-graph', gen_import_graph, []),
+    ('switch-array-literals', gen_switch_array_literals, []),
+    ('optimization-O0', gen_optimization, ['-O0']),
+    ('optimization-O3', gen_optimization, ['-O3', '-release']),
+]
+
+METRICS = ['wall', 'maxrss', 'parse', 'semantic', 'codegen']
+
+
+def write_file(dir, name, contents):
+    path = os.path.join(dir, name)
+    with open(path, 'w') as f:
+        f.write(contents)
+    return path
+
+
+def median(values):
+    values = sorted(values)
+    mid = len(values) // 2
+    if len(values) % 2:
+        return values[mid]
+    return (values[mid - 1] + values[mid]) / 2.0
+
+
+def compile_once(ldc, args, cwd):
+    """Runs the compiler once and returns its wall time."""
+    start = time.time()
+    proc = subprocess.Popen([ldc] + args, cwd=cwd, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    output = proc.communicate()[0]
+    wall = time.time() - start
+
+    if proc.returncode != 0:
+        sys.stderr.write(output)
+        raise RuntimeError('compilation failed: %s' % ' '.join(args))
+    return wall
+
+
+def compile_stats(ldc, args, cwd):
+    """Compiles once with -stats-file and returns the phase times and the peak
+    memory usage reported by the compiler."""
+    statsFile = os.path.join(cwd, 'stats.json')
+    compile_once(ldc, args + ['-stats-file=' + statsFile], cwd)
+    with open(statsFile) as f:
+        stats = json.load(f)
+    phases = stats.get('phases', {})
+    return {
+        'maxrss': stats.get('peak-memory', 0),
+        'parse': phases.get('parse', 0),
+        'semantic': phases.get('semantic', 0),
+        'codegen': phases.get('codegen', 0),
+    }
+
+
+def run_benchmark(ldc, name, generator, flags, repeat, workdir):
+    srcdir = os.path.join(workdir, name)
+    os.makedirs(srcdir)
+    files = generator(srcdir)
+    args = ['-c', '-singleobj', '-of=' + name + '.o'] + flags + \
+        [os.path.basename(f) for f in files]
+
+    result = compile_stats(ldc, args, srcdir)
+    result['wall'] = median([compile_once(ldc, args, srcdir)
+                             for _ in range(repeat)])
+    return result
+
+
+def compare(results, baseline, threshold):
+    """Prints a comparison table; returns the list of regressions."""
+    regressions = []
+    fmt = '%-24s %-9s %14s %14s %9s'
+    print(fmt % ('benchmark', 'metric', 'baseline', 'current', 'change'))
+    for name in sorted(results):
+        for m in METRICS:
+            cur = results[name][m]
+            base = baseline.get(name, {}).get(m)
+            if not base:
+                print(fmt % (name, m, '-', format_metric(m, cur), '-'))
+                continue
+            change = (cur - base) / float(base)
+            flag = ''
+            # Phase times are from a single run; only gate on wall time and
+            # memory.
+            if m in ('wall', 'maxrss') and change > threshold:
+                regressions.append((name, m, change))
+                flag = '  REGRESSION'
+            print(fmt % (name, m, format_metric(m, base),
+                         format_metric(m, cur), '%+.1f%%' % (change * 100)) + flag)
+    return regressions
+
+
+def format_metric(metric, value):
+    if metric == 'maxrss':
+        return '%.1f MiB' % (value / (1024.0 * 1024.0))
+    return '%.3f s' % value
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--ldc', required=True, help='path to the ldc2 binary')
+    parser.add_argument('--baseline', help='baseline JSON file to compare to')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='store the results as the new baseline')
+    parser.add_argument('--output', help='write the results to this JSON file')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='relative regression threshold (default: 0.1)')
+    parser.add_argument('--repeat', type=int, default=3,
+                        help='compilations per benchmark (default: 3)')
+    parser.add_argument('--filter', default='',
+                        help='only run benchmarks containing this string')
+    args = parser.parse_args()
+
+    workdir = tempfile.mkdtemp(prefix='ldc-compile-bench-')
+    try:
+        results = {}
+        for name, generator, flags in BENCHMARKS:
+            if args.filter not in name:
+                continue
+            print('Running %s...' % name)
+            sys.stdout.flush()
+            results[name] = run_benchmark(args.ldc, name, generator, flags,
+                                          args.repeat, workdir)
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    baseline = {}
+    if args.baseline and os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    regressions = compare(results, baseline, args.threshold)
+
+    if args.update_baseline and args.baseline:
+        baseline.update(results)
+        with open(args.baseline, 'w') as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+        print('Baseline updated: %s' % args.baseline)
+        return 0
+
+    if regressions:
+        print('\n%d regression(s) above %.0f%%:' %
+              (len(regressions), args.threshold * 100))
+        for name, metric, change in regressions:
+            print('  %s %s: %+.1f%%' % (name, metric, change * 100))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())